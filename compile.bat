@@ -2,13 +2,26 @@ cd %cd%
 
 g++^
  "src/main.cpp"^
+ "src/scan.cpp"^
  "src/PNG/CRC32.cpp"^
  "src/PNG/Chunks/IHDR_CHUNK.cpp"^
  "src/PNG/Chunks/PHYS_CHUNK.cpp"^
  "src/PNG/Chunks/IDAT_CHUNK.cpp"^
  "src/PNG/Chunks/IEND_CHUNK.cpp"^
+ "src/PNG/Chunks/CHUNK_INDEX.cpp"^
  "src/PNG/PNG.cpp"^
  "src/PNG/Utilities.cpp"^
+ "src/PNG/INPUT_FILE.cpp"^
+ "src/PNG/INFLATER.cpp"^
+ "src/PNG/ROW_DECODER.cpp"^
+ "src/PNG/CORPUS_INDEX.cpp"^
+ "src/PNG/Filters.cpp"^
+ "src/PNG/Chunks/SGIX_CHUNK.cpp"^
+ "src/PNG/ROW_INDEX.cpp"^
+ "src/PNG/Formats.cpp"^
+ "src/PNG/Chunks/PLTE_CHUNK.cpp"^
+ "src/PNG/Chunks/TRNS_CHUNK.cpp"^
+ "src/PNG/FILTER_STRATEGY.cpp"^
  -c -L"./lib" -m32 -lopengl32 -lglut32 -lz
 
 @echo off
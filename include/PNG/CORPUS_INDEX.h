@@ -0,0 +1,47 @@
+#ifndef _CORPUS_INDEX_H_INCLUDED_
+#define _CORPUS_INDEX_H_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "PNG.h"
+
+
+/**
+ * @brief CORPUS INDEX class, metadatas of all the png files of a directory tree.
+ * @details files are scanned by a pool of threads, and only the png header and the chunks headers are read(no decoding),
+ * so the scan is bound by the disk throughput. the index can be saved as CSV or as a compact binary file.
+ */
+class CORPUS_INDEX
+{
+    public :
+        /**
+         * @brief metadatas of a single png file
+         *
+         */
+        struct RECORD
+        {
+            std::string path; /**< the png file path*/
+            uint64_t fileSize = 0; /**< the png file length*/
+            PNG::INFO info = {}; /**< the png header informations*/
+            uint32_t IDATCount = 0; /**< the number of IDAT chunks*/
+            std::vector<std::string> chunks; /**< all the chunks types, in file order*/
+            std::string error; /**< empty, or the reason why the file couldn't be scanned*/
+        };
+
+        CORPUS_INDEX(const std::string &directory, int threads = 0);
+        ~CORPUS_INDEX();
+
+        const std::vector<RECORD> &get_records() const noexcept;
+
+        void save_csv(const std::string &path) const;
+        void save_binary(const std::string &path) const;
+
+        static RECORD scan(const std::string &path);
+
+    private :
+        std::vector<RECORD> m_records; /**< the png files metadatas, sorted by path*/
+};
+
+#endif // _CORPUS_INDEX_H_INCLUDED_
@@ -1,6 +1,8 @@
 #ifndef _CRC_32_H_INCLUDED_
 #define _CRC_32_H_INCLUDED_
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 
 /**
@@ -13,11 +15,11 @@ class CRC32
         CRC32();
         ~CRC32();
         void crc_table_compute();
-        static unsigned long getCRC32(uint8_t *chunkDatas, int chunkLen);
-        static unsigned long CRC32_update(unsigned long crc, uint8_t *dataCHUNK, int len);
+        static unsigned long getCRC32(const uint8_t *chunkDatas, std::size_t chunkLen);
+        static unsigned long CRC32_update(unsigned long crc, const uint8_t *dataCHUNK, std::size_t len);
         static void CRC32_table_compute(void);
 
-        static unsigned long crc_table[255];
+        static unsigned long crc_table[256];
         static bool crc_table_computed;
 };
 
@@ -0,0 +1,41 @@
+#ifndef _CHUNK_INDEX_H_INCLUDED_
+#define _CHUNK_INDEX_H_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../INPUT_FILE.h"
+
+
+/**
+ * @brief CHUNK INDEX class, list of all the chunks of a png file, built in a single sequential pass.
+ * @details the index follows the chunks length fields (signature -> length/type/data/crc -> next chunk...),
+ * so the file content(compressed datas) is never scanned, and a chunk type can't be matched inside another chunk datas.
+ */
+class CHUNK_INDEX
+{
+    public :
+        /**
+         * @brief a single chunk position inside the png file
+         *
+         */
+        struct ENTRY
+        {
+            uint64_t offset; /**< the position of the chunk datas(just after the chunk type) from the file beginning*/
+            uint32_t length; /**< the length of the chunk datas*/
+            std::string type; /**< the chunk type, 4 characters(IHDR, IDAT, pHYs, ...)*/
+        };
+
+        CHUNK_INDEX(INPUT_FILE &input);
+        ~CHUNK_INDEX();
+
+        const std::vector<ENTRY> &get_entries() const noexcept;
+        const ENTRY *find(const std::string &type) const noexcept;
+        std::vector<const ENTRY *> find_all(const std::string &type) const;
+
+    private :
+        std::vector<ENTRY> m_entries; /**< the chunks entries, in file order*/
+};
+
+#endif // _CHUNK_INDEX_H_INCLUDED_
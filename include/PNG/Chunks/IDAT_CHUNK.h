@@ -2,6 +2,8 @@
 #define _IDAT_CHUNK_H_INCLUDED_
 
 #include <cstdio>
+#include <vector>
+#include <cstdint>
 #include <thread>
 #include <future>
 #include <cstring>
@@ -9,6 +11,8 @@
 #include <iostream>
 #include <algorithm>
 
+#include "../FILTER_STRATEGY.h"
+
 
 /**
  * @brief IDAT CHUNK class, CRITICAL.
@@ -17,21 +21,26 @@
 class IDAT_CHUNK
 {   
     public :
-        IDAT_CHUNK(const uint8_t *pixelsBuffer, int s_width, int s_height, int colorChannel, int compress_mode);
+        IDAT_CHUNK(const uint8_t *pixelsBuffer, int s_width, int s_height, int colorChannel, int compress_mode, int segment_rows = 0,
+                   const FILTER_STRATEGY &strategy = FILTER_STRATEGY::CARDINAL());
         ~IDAT_CHUNK();
         
         void save(std::ofstream &outputStream);
 
     private : 
-        int m_length; /**< the length of the CHUNK */
+        static const uint32_t MAX_LENGTH = 0x7FFFFFFF; /**< the maximum length of a single chunk datas(2^31 - 1 bytes, png specification)*/
+
+        std::size_t m_length; /**< the length of the deflated datas, written as several IDAT chunks when longer than MAX_LENGTH */
         uint8_t *m_type = nullptr; /**< the type of the CHUNK corresponding to the name of the chunk in hexadecimal*/
         uint8_t *m_data = nullptr; /**< the datas inside the CHUNK, coresponding to the deflated scanlines generated from the input pixels buffer*/
         uint8_t *pixelsBuffer = nullptr; /**< the input pixels buffer*/
-        unsigned long m_crc32; /**< the crc32 value computed from the concatened buffers of type and datas*/
+        int m_segmentRows = 0; /**< the number of lines of each independently inflatable segment, 0 for a single deflate stream segment*/
+        std::vector<uint64_t> m_segmentOffsets; /**< the position of each segment in the datas, empty if not segmented*/
+        uint64_t m_trials = 0; /**< the number of lines whose filter mode was selected by a full trial*/
+        uint64_t m_candidates = 0; /**< the number of filtered lines evaluated by the strategy*/
 
-        uint8_t *generate_scanlines(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel);
-        uint8_t *deflate_datas(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel, int &deflatedLen, int compress_mode);
-        uint8_t *filter_line(const uint8_t *line_in, int lineLength, uint8_t filterMode, bool is_prev_line, const uint8_t *unfiltered_prev_line, uint8_t colorChannel);
+        uint8_t *generate_scanlines(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel, int segment_rows, const FILTER_STRATEGY &strategy);
+        uint8_t *deflate_datas(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel, std::size_t &deflatedLen, int compress_mode, int segment_rows, const FILTER_STRATEGY &strategy);
 
     friend class PNG;
 };
@@ -0,0 +1,32 @@
+#ifndef _PLTE_CHUNK_H_INCLUDED_
+#define _PLTE_CHUNK_H_INCLUDED_
+
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+
+/**
+ * @brief PLTE CHUNK class, CRITICAL for indexed images(color mode 3).
+ * @details datas : 1 to 256 palette entries of 3 bytes(red, green, blue), the pixels of an indexed image being indexes in this palette.
+ */
+class PLTE_CHUNK
+{
+    public :
+        PLTE_CHUNK(const uint8_t *datas, uint32_t length);
+        ~PLTE_CHUNK();
+
+        int get_entries_count() const noexcept;
+
+        void save(std::ofstream &outputStream);
+
+    private :
+        int m_length; /**< the length of the CHUNK */
+        uint8_t *m_type = nullptr; /**< the type of the CHUNK corresponding to the name of the chunk in hexadecimal*/
+        std::vector<uint8_t> m_entries; /**< the palette entries, 3 bytes(RGB) each*/
+        unsigned long m_crc32; /**< the crc32 value computed from the concatened buffers of type and datas*/
+
+    friend class PNG;
+};
+
+#endif // _PLTE_CHUNK_H_INCLUDED_
@@ -0,0 +1,37 @@
+#ifndef _SGIX_CHUNK_H_INCLUDED_
+#define _SGIX_CHUNK_H_INCLUDED_
+
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+
+/**
+ * @brief sgIX CHUNK class, AUXILIARY and PRIVATE.
+ * @details segments index of the IDAT datas : the deflate stream is fully flushed every rows_per_segment lines, and the first line of each segment
+ * is filtered without the previous line(None or Sub), so each segment can be inflated and unfiltered independently(on its own thread).
+ * datas : rows per segment(4 bytes), then for each segment its position in the deflate stream(8 bytes, 0 being the first byte of the zlib header).
+ * the chunk is unsafe to copy(4th letter uppercase), other png readers simply ignore it.
+ */
+class SGIX_CHUNK
+{
+    public :
+        SGIX_CHUNK(uint32_t rowsPerSegment, const std::vector<uint64_t> &offsets);
+        SGIX_CHUNK(const uint8_t *datas, uint32_t length);
+        ~SGIX_CHUNK();
+
+        void save(std::ofstream &outputStream);
+
+    private :
+        int m_length; /**< the length of the CHUNK */
+        uint8_t *m_type = nullptr; /**< the type of the CHUNK corresponding to the name of the chunk in hexadecimal*/
+        uint32_t m_rowsPerSegment; /**< the number of lines of each segment(the last one can be shorter)*/
+        std::vector<uint64_t> m_offsets; /**< the position of each segment in the deflate stream*/
+        unsigned long m_crc32; /**< the crc32 value computed from the concatened buffers of type and datas*/
+
+        std::vector<uint8_t> get_datas() const;
+
+    friend class PNG;
+};
+
+#endif // _SGIX_CHUNK_H_INCLUDED_
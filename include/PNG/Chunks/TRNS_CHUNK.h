@@ -0,0 +1,31 @@
+#ifndef _TRNS_CHUNK_H_INCLUDED_
+#define _TRNS_CHUNK_H_INCLUDED_
+
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+
+/**
+ * @brief tRNS CHUNK class, AUXILIARY.
+ * @details datas, according to the color mode : the alpha of the first palette entries(1 byte each, the others being opaque) for indexed images,
+ * the transparent gray level(2 bytes) for grayscale images, the transparent red, green, blue values(2 bytes each) for RGB images.
+ */
+class TRNS_CHUNK
+{
+    public :
+        TRNS_CHUNK(const uint8_t *datas, uint32_t length);
+        ~TRNS_CHUNK();
+
+        void save(std::ofstream &outputStream);
+
+    private :
+        int m_length; /**< the length of the CHUNK */
+        uint8_t *m_type = nullptr; /**< the type of the CHUNK corresponding to the name of the chunk in hexadecimal*/
+        std::vector<uint8_t> m_datas; /**< the transparency datas, as stored in the png file*/
+        unsigned long m_crc32; /**< the crc32 value computed from the concatened buffers of type and datas*/
+
+    friend class PNG;
+};
+
+#endif // _TRNS_CHUNK_H_INCLUDED_
@@ -0,0 +1,160 @@
+#ifndef _FILTER_STRATEGY_H_INCLUDED_
+#define _FILTER_STRATEGY_H_INCLUDED_
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "../zlib/zlib.h"
+
+
+/**
+ * @brief FILTER STRATEGY class, the scanlines filter selection of the encoder(see PNG::save()).
+ * @details for each line, the encoder tries the candidate filter modes and keeps the one with the lowest cost(the first one on equal costs),
+ * unless the strategy forces a filter mode. each encoding thread works on its own clone(), so a strategy can keep buffers between lines.
+ * a strategy may also propose the previous line filter mode(get_reused_filter()) : it's evaluated alone, the other candidates only if
+ * it's rejected(accept_reused()).
+ * new strategies derive from this class, the built-in ones are :
+ * FIXED(a single filter mode), CARDINAL(the fewest distinct bytes, default), SAD(the minimum sum of absolute differences, as libpng),
+ * ENTROPY(the lowest Shannon entropy), DEFLATE(the shortest line deflated with a fast zlib level),
+ * ADAPTIVE(another strategy, only tried again when the selected filter mode stops fitting).
+ */
+class FILTER_STRATEGY
+{
+    public :
+        /**
+         * @brief a filtered line candidate
+         * 
+         */
+        struct CANDIDATE
+        {
+            uint8_t filterMode; /**< the candidate filter mode( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)*/
+            const uint8_t *filtered; /**< the filtered line*/
+            std::size_t length; /**< the filtered line length*/
+            uint64_t sad; /**< the filtered line sum of absolute values(as signed bytes), computed while filtering*/
+        };
+
+        class FIXED;
+        class CARDINAL;
+        class SAD;
+        class ENTROPY;
+        class DEFLATE;
+        class ADAPTIVE;
+
+        virtual ~FILTER_STRATEGY() = default;
+
+        virtual int get_fixed_filter() const noexcept;
+        virtual int get_reused_filter() const noexcept;
+        virtual bool accept_reused(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad);
+        virtual void set_selected(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad);
+        virtual uint64_t get_cost(const CANDIDATE &candidate) = 0;
+        virtual std::unique_ptr<FILTER_STRATEGY> clone() const = 0;
+};
+
+/**
+ * @brief a single filter mode for all the lines
+ * @note the first line of a segment(see PNG::save()) can't depend on the previous line : Up is replaced by None, Average and Paeth by Sub.
+ */
+class FILTER_STRATEGY::FIXED : public FILTER_STRATEGY
+{
+    public :
+        FIXED(int filterMode);
+
+        int get_fixed_filter() const noexcept override;
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+
+    private :
+        int m_filterMode; /**< the filter mode of all the lines*/
+};
+
+/**
+ * @brief the filtered line with the fewest distinct bytes(the highest values repetitions)
+ * 
+ */
+class FILTER_STRATEGY::CARDINAL : public FILTER_STRATEGY
+{
+    public :
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+};
+
+/**
+ * @brief the filtered line with the minimum sum of absolute differences(bytes taken as signed values), the libpng heuristic
+ * 
+ */
+class FILTER_STRATEGY::SAD : public FILTER_STRATEGY
+{
+    public :
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+};
+
+/**
+ * @brief the filtered line with the lowest Shannon entropy(its size in bits with an ideal order 0 coder)
+ * 
+ */
+class FILTER_STRATEGY::ENTROPY : public FILTER_STRATEGY
+{
+    public :
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+};
+
+/**
+ * @brief the filtered line with the shortest deflated size, each line being deflated alone(trial compression)
+ * @note the slowest strategy but the closest to the real output size, a fast level(default Z_BEST_SPEED) keeps it affordable.
+ */
+class FILTER_STRATEGY::DEFLATE : public FILTER_STRATEGY
+{
+    public :
+        DEFLATE(int level = Z_BEST_SPEED);
+        DEFLATE(const DEFLATE &strategy);
+        DEFLATE &operator=(const DEFLATE &) = delete;
+        ~DEFLATE();
+
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+
+    private :
+        int m_level; /**< the zlib compression level of the trials*/
+        bool m_initialised = false; /**< if the deflate stream is initialised(at the first trial)*/
+        z_stream m_stream; /**< the deflate stream, reset for each trial*/
+        std::vector<uint8_t> m_output; /**< the trials output buffer*/
+};
+
+/**
+ * @brief another strategy, the selected filter mode being reused on the next lines while its cost stays close to the running estimate
+ * of the selected costs : the filters of a photo or a screenshot change seldom from a line to the next one, most lines are evaluated
+ * once instead of five times.
+ * @details the sums of absolute values, given with the candidates, are a cheap hint of a better filter : the reused filter one must not
+ * exceed the lowest one much more than at the last full trial.
+ * @note a full trial is done every period lines at least, or when the reused filter cost(or its sum excess) drifts by more than tolerance.
+ */
+class FILTER_STRATEGY::ADAPTIVE : public FILTER_STRATEGY
+{
+    public :
+        ADAPTIVE(const FILTER_STRATEGY &strategy = CARDINAL(), int period = 16, double tolerance = 0.05);
+        ADAPTIVE(const ADAPTIVE &strategy);
+        ADAPTIVE &operator=(const ADAPTIVE &) = delete;
+
+        int get_fixed_filter() const noexcept override;
+        int get_reused_filter() const noexcept override;
+        bool accept_reused(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad) override;
+        void set_selected(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad) override;
+        uint64_t get_cost(const CANDIDATE &candidate) override;
+        std::unique_ptr<FILTER_STRATEGY> clone() const override;
+
+    private :
+        std::unique_ptr<FILTER_STRATEGY> m_strategy; /**< the strategy giving the costs*/
+        int m_period; /**< the maximum number of lines between two full trials*/
+        double m_tolerance; /**< the accepted cost excess of the reused filter mode, relative to the estimate*/
+
+        int m_filterMode = -1; /**< the filter mode selected by the last full trial, -1 before the first one*/
+        int m_reusedLines = 0; /**< the number of lines since the last full trial*/
+        double m_estimate = 0.0; /**< the running estimate of the selected filter mode cost*/
+        double m_excess = 1.0; /**< the ratio of the selected filter mode sum of absolute values to the lowest one, at the last full trial*/
+};
+
+#endif // _FILTER_STRATEGY_H_INCLUDED_
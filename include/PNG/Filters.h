@@ -0,0 +1,17 @@
+#ifndef _FILTERS_H_INCLUDED_
+#define _FILTERS_H_INCLUDED_
+
+#include <cstdint>
+
+/**
+ * @brief png scanlines filtering kernels, shared by the encoder and the decoders
+ */
+namespace Filters
+{
+    void filter_line(const uint8_t *line, uint8_t *filtered, int lineLength, uint8_t filterMode, const uint8_t *unfiltered_prev_line, uint8_t colorChannel);
+    void filter_candidates(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *unfiltered_prev_line, uint8_t colorChannel, uint64_t *sads);
+    void unfilter_line(uint8_t *line, int lineLength, uint8_t filterMode, const uint8_t *unfiltered_prev_line, uint8_t colorChannel);
+    const char *get_simd_level();
+};
+
+#endif //_FILTERS_H_INCLUDED_
@@ -0,0 +1,21 @@
+#ifndef _FORMATS_H_INCLUDED_
+#define _FORMATS_H_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief decoded pixels formats kernels, applied on each unfiltered line while it's still in cache
+ */
+namespace Formats
+{
+    void swap_16(uint8_t *samples, std::size_t length);
+    void convert_line(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int bitDepth, int outChannels, bool bgr);
+    void unpack_line(const uint8_t *packed, uint8_t *output, std::size_t pixels, int bitDepth);
+    void pack_line(const uint8_t *pixels, uint8_t *packed, std::size_t count, int bitDepth);
+    void expand_line(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut, int bitDepth);
+    void mask_transparent(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int bitDepth, const uint16_t *key);
+    const char *get_simd_level();
+};
+
+#endif //_FORMATS_H_INCLUDED_
@@ -0,0 +1,48 @@
+#ifndef _INFLATER_H_INCLUDED_
+#define _INFLATER_H_INCLUDED_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "../zlib/zlib.h"
+
+#include "INPUT_FILE.h"
+#include "Chunks/CHUNK_INDEX.h"
+
+
+/**
+ * @brief INFLATER class, streaming inflate() of the IDAT chunks datas.
+ * @details the IDAT chunks are consumed in file order, only when zlib needs more input : the compressed stream is never stored as a whole,
+ * and the scanlines can be inflated by parts(line by line for example).
+ */
+class INFLATER
+{
+    public :
+        INFLATER(INPUT_FILE &input, const CHUNK_INDEX &chunks);
+        INFLATER(const INFLATER &) = delete;
+        INFLATER &operator=(const INFLATER &) = delete;
+        ~INFLATER();
+
+        void read(uint8_t *output, std::size_t length);
+        std::size_t read_block(uint8_t *output, std::size_t length);
+        void finish();
+        void seek(uint64_t position, int bits, const uint8_t *window, std::size_t windowLength);
+
+        uint64_t get_position() const noexcept;
+        int get_bits() const noexcept;
+        bool is_block_boundary() const noexcept;
+
+    private :
+        INPUT_FILE &m_input; /**< the png input file*/
+        std::vector<const CHUNK_INDEX::ENTRY *> m_IDATs; /**< the IDAT chunks, in file order*/
+        std::size_t m_nextIDAT = 0; /**< the next IDAT chunk to give to zlib*/
+        std::vector<uint8_t> m_buffer; /**< IDAT chunk reading buffer, only used if the file is not mapped*/
+        z_stream m_stream; /**< the zlib inflate stream*/
+        bool m_finished = false; /**< if the end of the deflate stream is reached*/
+        uint64_t m_start = 0; /**< the deflate stream position where zlib started(not 0 after a seek)*/
+
+        void next_chunk();
+};
+
+#endif // _INFLATER_H_INCLUDED_
@@ -0,0 +1,47 @@
+#ifndef _INPUT_FILE_H_INCLUDED_
+#define _INPUT_FILE_H_INCLUDED_
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+
+
+/**
+ * @brief INPUT FILE class, read-only access to the bytes of a png file.
+ * @details when possible the file is memory mapped, and reading a range of the file directly returns a pointer inside the mapping(no copy).
+ * otherwise(pipes, non-mappable files, or mapping not requested), the file is read through a buffered stream,
+ * and non seekable streams are entirely loaded in memory.
+ */
+class INPUT_FILE
+{
+    public :
+        INPUT_FILE(const std::string &path, bool try_mapping = true);
+        INPUT_FILE(const INPUT_FILE &) = delete;
+        INPUT_FILE &operator=(const INPUT_FILE &) = delete;
+        ~INPUT_FILE();
+
+        bool is_mapped() const noexcept;
+        uint64_t get_size() const noexcept;
+
+        const uint8_t *read(uint64_t offset, uint32_t length, std::vector<uint8_t> &buffer);
+
+    private :
+        uint64_t m_size = 0; /**< the file length*/
+        const uint8_t *m_mapping = nullptr; /**< the file mapping, nullptr if not mapped*/
+        std::ifstream m_stream; /**< the buffered stream, used if the file is not mapped*/
+        std::mutex m_stream_mutex; /**< serializes the buffered stream readings*/
+        std::vector<uint8_t> m_content; /**< the whole file content, used if the stream is not seekable(pipes)*/
+        bool m_in_memory = false; /**< if the file content is stored in m_content*/
+
+#ifdef _WIN32
+        void *m_file_handle = nullptr; /**< windows file handle*/
+        void *m_map_handle = nullptr; /**< windows file mapping handle*/
+#endif
+
+        bool map(const std::string &path);
+        void unmap() noexcept;
+};
+
+#endif // _INPUT_FILE_H_INCLUDED_
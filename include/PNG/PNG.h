@@ -6,6 +6,7 @@
 #include <vector>
 #include <cstdio>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 
@@ -15,6 +16,14 @@
 #include "Chunks/PHYS_CHUNK.h"
 #include "Chunks/IDAT_CHUNK.h"
 #include "Chunks/IEND_CHUNK.h"
+#include "Chunks/SGIX_CHUNK.h"
+#include "Chunks/PLTE_CHUNK.h"
+#include "Chunks/TRNS_CHUNK.h"
+#include "Chunks/CHUNK_INDEX.h"
+
+#include "INFLATER.h"
+#include "FILTER_STRATEGY.h"
+#include "INPUT_FILE.h"
 
 /**
  * 
@@ -24,8 +33,72 @@
 class PNG
 {
     public :
+        /**
+         * @brief png header informations, as stored in the IHDR chunk
+         * 
+         */
+        struct INFO
+        {
+            int width; /**< the png width*/
+            int height; /**< the png height*/
+            uint8_t bitDepth; /**< the png bit depth*/
+            uint8_t colorMode; /**< the png color mode*/
+            uint8_t compression; /**< the compression method(always 0, deflate)*/
+            uint8_t filter; /**< the filter method(always 0)*/
+            uint8_t interlacing; /**< the interlacing method(0 none, 1 Adam7)*/
+        };
+
+        /**
+         * @brief the unfiltering parallelism found by the last decoding
+         * @note a run is a band of lines unfiltered on its own, the speedup is bounded by the height divided by the longest run.
+         * 
+         */
+        struct PARALLELISM
+        {
+            int runs; /**< the number of independently unfiltered runs(1 for a sequential decoding)*/
+            int longestRun; /**< the number of lines of the longest run*/
+            int threads; /**< the number of threads used for unfiltering*/
+        };
+
+        /**
+         * @brief the filter selection work of the last save()
+         * @note a full trial evaluates the five filters of a line(two on a segment first line), an adaptive strategy(FILTER_STRATEGY::ADAPTIVE)
+         * evaluates the reused filter alone on most lines. a fixed filter(FILTER_STRATEGY::FIXED) evaluates nothing.
+         * 
+         */
+        struct FILTERING
+        {
+            uint64_t lines; /**< the number of encoded lines*/
+            uint64_t trials; /**< the number of lines whose filter was selected by a full trial*/
+            uint64_t candidates; /**< the number of filtered lines evaluated by the strategy, candidates / lines filters per line*/
+        };
+
+        /**
+         * @brief the low resolution image of an interlaced png, after one of its Adam7 passes
+         * @note each pixel of the low resolution image is the top-left pixel of a blockWidth x blockHeight block of the png,
+         * the pixels are in the png lines layout(1, 2 and 4 bits pixels packed) and valid during the callback only.
+         * 
+         */
+        struct PASS
+        {
+            int pass; /**< the Adam7 pass just decoded, 1 to 7(the full image)*/
+            int width; /**< the low resolution image width*/
+            int height; /**< the low resolution image height*/
+            int blockWidth; /**< the png columns per low resolution pixel, 8 to 1*/
+            int blockHeight; /**< the png lines per low resolution pixel, 8 to 1*/
+            std::size_t stride; /**< the number of bytes of a low resolution line*/
+            const uint8_t *pixels; /**< the low resolution pixels*/
+        };
+
+        /**
+         * @brief the callback receiving each Adam7 pass low resolution image, during the decoding
+         * 
+         */
+        typedef std::function<void(const PASS &)> PASS_CALLBACK;
+
         PNG(const PNG &png);
-        PNG(const std::string &path);
+        PNG(const std::string &path, int decode_mode = DECODE::MAPPED, int endianness = ENDIANNESS::BIG, int unfilter_mode = UNFILTER::SEQUENTIAL,
+            int packing = PACKING::BYTE, const PASS_CALLBACK &on_pass = nullptr);
         PNG(const uint8_t *pixelBuffer, int s_width, int s_height, int bitDepth, int colorMode);
         ~PNG();
 
@@ -35,10 +108,30 @@ class PNG
         uint8_t get_bitDepth() const noexcept;
         uint8_t get_colorMode() const noexcept;
         uint8_t get_interlacing() const noexcept;
+        int get_decode_mode() const noexcept;
+        int get_endianness() const noexcept;
+        PARALLELISM get_parallelism() const noexcept;
+        FILTERING get_filtering() const noexcept;
+        int get_packing() const noexcept;
+        std::vector<uint8_t> get_palette() const;
 
         uint8_t *get_raw_pixels() const;
+        uint16_t *get_raw_samples() const;
+        uint8_t *get_rgba_pixels() const;
 
-        void save(const std::string &path, int compress_mode = COMPRESS::DEFAULT);
+        static INFO probe(const std::string &path);
+        static INFO probe(const uint8_t *buffer, std::size_t length);
+
+        static void decode_into(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride, int decode_mode = DECODE::MAPPED,
+                                int format = FORMAT::ORIGINAL);
+        static void decode_region(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride,
+                                  int first_row, int rows, int first_column = 0, int columns = -1, int decode_mode = DECODE::MAPPED,
+                                  int format = FORMAT::ORIGINAL);
+        static void decode_scaled(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride,
+                                  int scale, int sampling = SAMPLING::BOX, int decode_mode = DECODE::MAPPED);
+
+        void save(const std::string &path, int compress_mode = COMPRESS::DEFAULT, int segment_rows = 0,
+                  const FILTER_STRATEGY &strategy = FILTER_STRATEGY::CARDINAL());
 
         PNG &operator=(const PNG &png_src);
         
@@ -48,18 +141,73 @@ class PNG
          */
         enum COMPRESS{BEST = Z_BEST_COMPRESSION, SPEED = Z_BEST_SPEED, DEFAULT = Z_DEFAULT_COMPRESSION, NO = Z_NO_COMPRESSION};
 
+        /**
+         * @brief input file reading modes for decoding, MAPPED falls back to BUFFERED when the file can't be memory mapped
+         * 
+         */
+        enum DECODE{MAPPED, BUFFERED};
+
+        /**
+         * @brief reduced resolution decoding methods, BOX averages each scale x scale block, POINT keeps its top-left pixel
+         * 
+         */
+        enum SAMPLING{BOX, POINT};
+
+        /**
+         * @brief 16 bits samples byte order of the decoded pixels, BIG as stored in png files or NATIVE(the host byte order)
+         * 
+         */
+        enum ENDIANNESS{BIG, NATIVE};
+
+        /**
+         * @brief unfiltering modes, PARALLEL inflates all the lines first then unfilters the runs starting at lines
+         * filtered with None or Sub(they don't depend on the previous line) on several threads,
+         * PIPELINED inflates on a thread while the calling thread unfilters the lines behind it
+         * 
+         */
+        enum UNFILTER{SEQUENTIAL, PARALLEL, PIPELINED};
+
+        /**
+         * @brief output pixels formats for decoding into caller buffers, ORIGINAL keeps the png layout,
+         * the others are 8 bits RGB/BGR(A) pixels converted line by line during the decoding
+         * 
+         */
+        enum FORMAT{ORIGINAL, RGB8, RGBA8, BGR8, BGRA8};
+
+        /**
+         * @brief pixels storage of the 1, 2 and 4 bits images(palette indexes or gray levels), BYTE keeps a pixel per byte,
+         * PACKED keeps the png lines layout((width * bitDepth + 7) / 8 bytes per line)
+         * 
+         */
+        enum PACKING{BYTE, PACKED};
+
     private : 
         uint8_t *m_signature = nullptr; /**< the default signature of all PNG files*/
         uint8_t *m_pixelBuffer = nullptr; /**< the raw pixels buffer that should contain the PNG file*/
+        int m_decodeMode = DECODE::BUFFERED; /**< the input file reading mode effectively used for decoding*/
+        int m_endianness = ENDIANNESS::BIG; /**< the byte order of the 16 bits samples inside the pixels buffer*/
+        PARALLELISM m_parallelism = {1, 0, 1}; /**< the unfiltering parallelism found by the decoding*/
+        FILTERING m_filtering = {0, 0, 0}; /**< the filter selection work of the last save*/
+        int m_packing = PACKING::BYTE; /**< the storage of the 1, 2 and 4 bits pixels inside the pixels buffer*/
+        uint8_t m_interlacing = 0x0; /**< the interlacing method of the decoded file, the pixels buffer being always de-interlaced*/
 
-        /** PNG CHUNKS objets : criticals(IHDR, IDAT, IEND) Optionals(pHYs)*/
+        /** PNG CHUNKS objets : criticals(IHDR, PLTE, IDAT, IEND) Optionals(pHYs, tRNS)*/
         IHDR_CHUNK *m_IHDR = nullptr;
+        PLTE_CHUNK *m_PLTE = nullptr;
         PHYS_CHUNK *m_pHYs = nullptr;
+        TRNS_CHUNK *m_tRNS = nullptr;
         IDAT_CHUNK *m_IDAT = nullptr;
         IEND_CHUNK *m_IEND = nullptr;
         
-        uint8_t *unfilter_line(const uint8_t *line_in, int lineLength, uint8_t filterMode, bool is_prev_line, const uint8_t *unfiltered_prev_line, uint8_t colorChannel);
-        uint8_t *readPixels(const std::string &path, int &s_width, int &s_height, uint8_t &bitDepth, uint8_t &colorMode, uint8_t &colorChannel, int &pixelsBufferLen);
+        uint8_t *readPixels(INPUT_FILE &input, const CHUNK_INDEX &chunks, int &s_width, int &s_height, uint8_t &bitDepth, uint8_t &colorMode, uint8_t &colorChannel, std::size_t &pixelsBufferLen, bool swap16, int unfilter_mode, const PASS_CALLBACK &on_pass);
+        std::size_t get_pixels_length() const;
+        std::vector<uint8_t> get_lut() const;
+        static int get_samples(int colorMode) noexcept;
+        static int get_format_size(int format);
+        static void decode_adam7(INFLATER &inflater, uint8_t *rawBuffer, int s_width, int s_height, int pixelBits, bool swap16, const PASS_CALLBACK &on_pass);
+        static void decode_pipelined(INFLATER &inflater, uint8_t *rawBuffer, int s_height, std::size_t rowLength, uint8_t colorChannel, bool swap16);
+        static PARALLELISM unfilter_runs(uint8_t *rawBuffer, const std::vector<uint8_t> &filters, std::size_t rowLength, uint8_t colorChannel, bool swap16);
+        static void decode_segments(INPUT_FILE &input, const CHUNK_INDEX &chunks, const SGIX_CHUNK &index, uint8_t *rawBuffer, std::size_t rowLength, int s_height, uint8_t colorChannel, bool swap16);
 };
 
 
@@ -0,0 +1,62 @@
+#ifndef _ROW_DECODER_H_INCLUDED_
+#define _ROW_DECODER_H_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "INFLATER.h"
+#include "INPUT_FILE.h"
+#include "Chunks/CHUNK_INDEX.h"
+
+
+/**
+ * @brief ROW DECODER class, pull-style png decoder giving the unfiltered pixels lines one after the other.
+ * @details only the actual line, the previous line(needed for unfiltering) and the zlib window are kept in memory,
+ * so the memory usage is proportional to the png width, not to the whole image size.
+ */
+class ROW_DECODER
+{
+    public :
+        ROW_DECODER(const std::string &path, bool try_mapping = true);
+        ROW_DECODER(const ROW_DECODER &) = delete;
+        ROW_DECODER &operator=(const ROW_DECODER &) = delete;
+        ~ROW_DECODER();
+
+        // accessors
+        int get_width() const noexcept;
+        int get_height() const noexcept;
+        uint8_t get_bitDepth() const noexcept;
+        uint8_t get_colorMode() const noexcept;
+        uint8_t get_colorChannel() const noexcept;
+        int get_row_length() const noexcept;
+        int get_row() const noexcept;
+        bool is_mapped() const noexcept;
+
+        const uint8_t *next_row();
+        void next_row(uint8_t *output);
+        int read_rows(uint8_t *output, int rows);
+        int skip_rows(int rows);
+        void decode_into(uint8_t *destination, std::size_t stride);
+
+    private :
+        INPUT_FILE m_input; /**< the png input file*/
+        CHUNK_INDEX m_chunks; /**< the chunks index of the png file*/
+        INFLATER m_inflater; /**< the IDAT datas inflater*/
+
+        int m_width = 0; /**< the png width */
+        int m_height = 0; /**< the png height */
+        uint8_t m_bitDepth = 0; /**< the png bit depth */
+        uint8_t m_colorMode = 0; /**< the png color mode */
+        uint8_t m_colorChannel = 0; /**< the number of bytes per pixel, according to the color mode and the bit depth */
+        int m_rowLength = 0; /**< the number of bytes of an unfiltered line */
+        int m_row = 0; /**< the index of the next line to decode */
+
+        std::vector<uint8_t> m_lines; /**< two internal lines, used alternately by next_row(), the second one is zeros before the first line*/
+        const uint8_t *m_prevLine = nullptr; /**< the previous unfiltered line, either internal or inside a caller buffer*/
+
+        void read_header();
+        void decode_row(uint8_t *line);
+};
+
+#endif // _ROW_DECODER_H_INCLUDED_
@@ -0,0 +1,65 @@
+#ifndef _ROW_INDEX_H_INCLUDED_
+#define _ROW_INDEX_H_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+/**
+ * @brief ROW INDEX class, random access to the lines of an existing png file.
+ * @details the index is built by a single inflate pass, recording checkpoints(deflate block boundaries) every spacing lines :
+ * the stream position, the last 32 KB inflated and the lines state. any line can then be decoded by restarting the inflate
+ * at the nearest checkpoint before it, instead of inflating the whole stream from its beginning.
+ * the index can be saved next to the png file and loaded later, so the indexing pass is done only once.
+ */
+class ROW_INDEX
+{
+    public :
+        /**
+         * @brief an inflate restart point, at a deflate block boundary
+         *
+         */
+        struct CHECKPOINT
+        {
+            uint64_t position; /**< the block boundary position in the deflate stream(the concatenation of the IDAT chunks datas)*/
+            uint8_t bits; /**< the number of bits of the byte before position belonging to the block(0 to 7)*/
+            uint64_t output; /**< the number of scanlines bytes inflated before the block boundary*/
+            std::vector<uint8_t> window; /**< the last bytes inflated before the block boundary(up to 32 KB)*/
+            std::vector<uint8_t> prevRow; /**< the last unfiltered line before the block boundary(zeros for the first line)*/
+            std::vector<uint8_t> partialRow; /**< the already inflated bytes(filter byte included) of the line containing the block boundary*/
+        };
+
+        ROW_INDEX(const std::string &path, int spacing = 64, bool try_mapping = true);
+        ~ROW_INDEX();
+
+        static ROW_INDEX load(const std::string &path);
+        void save(const std::string &path) const;
+
+        // accessors
+        int get_width() const noexcept;
+        int get_height() const noexcept;
+        int get_row_length() const noexcept;
+        int get_spacing() const noexcept;
+        const std::vector<CHECKPOINT> &get_checkpoints() const noexcept;
+
+        void decode_rows(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride,
+                         int first_row, int rows, bool try_mapping = true) const;
+
+    private :
+        ROW_INDEX();
+
+        uint64_t m_fileSize = 0; /**< the indexed png file length, for checking the index matches the file*/
+        uint8_t m_header[13] = {}; /**< the indexed png IHDR chunk datas, for checking the index matches the file*/
+        int m_width = 0; /**< the png width */
+        int m_height = 0; /**< the png height */
+        uint8_t m_colorChannel = 0; /**< the number of bytes per pixel */
+        int m_rowLength = 0; /**< the number of bytes of an unfiltered line */
+        int m_spacing = 0; /**< the minimal number of lines between two checkpoints*/
+        std::vector<CHECKPOINT> m_checkpoints; /**< the checkpoints, sorted by position*/
+
+        void set_header(const uint8_t *header);
+};
+
+#endif // _ROW_INDEX_H_INCLUDED_
@@ -0,0 +1,88 @@
+#ifndef _SPSC_RING_H_INCLUDED_
+#define _SPSC_RING_H_INCLUDED_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+
+/**
+ * @brief SPSC RING class, lock-free bounded queue between a single producer thread and a single consumer thread.
+ * @details the producer only writes the tail index and the consumer only writes the head index, each one reading the other
+ * with acquire semantic : a pushed value(and everything the producer wrote before pushing it) is visible to the consumer that pops it.
+ */
+template <typename T>
+class SPSC_RING
+{
+    public :
+        /**
+         * @brief Construct a new SPSC_RING object
+         *
+         * @param capacity the maximum number of values in the ring, rounded up to a power of two
+         */
+        SPSC_RING(std::size_t capacity)
+        {
+            std::size_t size(1);
+            while (size < capacity)
+                size <<= 1;
+
+            m_slots.resize(size);
+            m_mask = size - 1;
+        }
+
+        SPSC_RING(const SPSC_RING &) = delete;
+        SPSC_RING &operator=(const SPSC_RING &) = delete;
+
+        /**
+         * @brief method for pushing a value, producer thread only
+         *
+         * @param value the value to push
+         * @return either false if the ring is full or true
+         */
+        bool push(const T &value)
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+                return false;
+
+            m_slots[tail & m_mask] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief method for popping the oldest value, consumer thread only
+         *
+         * @param value the popped value
+         * @return either false if the ring is empty or true
+         */
+        bool pop(T &value)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            value = m_slots[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief get the maximum number of values in the ring
+         *
+         * @return std::size_t
+         */
+        std::size_t get_capacity() const noexcept
+        {
+            return m_slots.size();
+        }
+
+    private :
+        std::vector<T> m_slots; /**< the ring values*/
+        std::size_t m_mask = 0; /**< the slots count minus one, for wrapping the indexes*/
+
+        alignas(64) std::atomic<std::size_t> m_head{0}; /**< the number of popped values, written by the consumer*/
+        alignas(64) std::atomic<std::size_t> m_tail{0}; /**< the number of pushed values, written by the producer*/
+};
+
+#endif // _SPSC_RING_H_INCLUDED_
@@ -4,6 +4,8 @@
 #include <map>
 #include <cmath>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 #include <fstream>
 #include <cstring>
 #include <iostream>
@@ -15,21 +17,23 @@ namespace Utilities
 {
     bool is_bigEndian(void);
 
-    uint8_t *int_to_uint8(int number);
+    uint8_t *int_to_uint8(uint32_t number);
     int uint8_to_int(uint8_t *ptr);
 
-    uint8_t *invertArray(uint8_t *array, int len);
-    uint8_t *getConcatenedArray(uint8_t *array1, uint8_t *array2, int len1, int len2);
+    uint8_t *invertArray(uint8_t *array, std::size_t len);
+    uint8_t *getConcatenedArray(uint8_t *array1, uint8_t *array2, std::size_t len1, std::size_t len2);
 
-    int f_len(std::ifstream &input);
-    int f_strchr(std::ifstream &input, std::string word, int limit);
-    std::vector<int> f_strchr(std::ifstream &input, const std::string word);
+    int64_t f_len(std::ifstream &input);
+    int64_t f_strchr(std::ifstream &input, std::string word, int64_t limit);
+    std::vector<int64_t> f_strchr(std::ifstream &input, const std::string word);
 
-    void stream_write(const uint8_t *src, int src_size, std::ofstream &ouputStream);
+    void stream_write(const uint8_t *src, std::size_t src_size, std::ofstream &ouputStream);
 
     void flipPixels(uint8_t *pixelsBuffer, int s_width, int s_heigth, int colorChannel);
     int paeth_predictor(uint8_t left, uint8_t up, uint8_t upperLeft);
-    int get_cardinal(uint8_t *buffer, int buffer_len) noexcept;
+    int get_cardinal(const uint8_t *buffer, std::size_t buffer_len) noexcept;
+    int get_histogram(const uint8_t *buffer, std::size_t buffer_len, uint32_t *histogram) noexcept;
+    std::size_t get_buffer_length(int s_width, int s_height, int colorChannel);
 };
 
 #endif //_UTILITIES_H_INCLUDED_
\ No newline at end of file
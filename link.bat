@@ -7,11 +7,47 @@ g++^
  "bin/link/PHYS_CHUNK.o" ^
  "bin/link/IDAT_CHUNK.o" ^
  "bin/link/IEND_CHUNK.o" ^
+ "bin/link/CHUNK_INDEX.o" ^
  "bin/link/PNG.o" ^
  "bin/link/Utilities.o" ^
+ "bin/link/INPUT_FILE.o" ^
+ "bin/link/INFLATER.o" ^
+ "bin/link/ROW_DECODER.o" ^
+ "bin/link/CORPUS_INDEX.o" ^
+ "bin/link/Filters.o" ^
+ "bin/link/SGIX_CHUNK.o" ^
+ "bin/link/ROW_INDEX.o" ^
+ "bin/link/Formats.o" ^
+ "bin/link/PLTE_CHUNK.o" ^
+ "bin/link/TRNS_CHUNK.o" ^
+ "bin/link/FILTER_STRATEGY.o" ^
  -o "./bin/output.exe"^
  -L"./lib" -m32 -lopengl32 -lglut32 -lz
 
+g++^
+ "bin/link/scan.o"^
+ "bin/link/CRC32.o"^
+ "bin/link/IHDR_CHUNK.o" ^
+ "bin/link/PHYS_CHUNK.o" ^
+ "bin/link/IDAT_CHUNK.o" ^
+ "bin/link/IEND_CHUNK.o" ^
+ "bin/link/CHUNK_INDEX.o" ^
+ "bin/link/PNG.o" ^
+ "bin/link/Utilities.o" ^
+ "bin/link/INPUT_FILE.o" ^
+ "bin/link/INFLATER.o" ^
+ "bin/link/ROW_DECODER.o" ^
+ "bin/link/CORPUS_INDEX.o" ^
+ "bin/link/Filters.o" ^
+ "bin/link/SGIX_CHUNK.o" ^
+ "bin/link/ROW_INDEX.o" ^
+ "bin/link/Formats.o" ^
+ "bin/link/PLTE_CHUNK.o" ^
+ "bin/link/TRNS_CHUNK.o" ^
+ "bin/link/FILTER_STRATEGY.o" ^
+ -o "./bin/scan.exe"^
+ -L"./lib" -m32 -lopengl32 -lglut32 -lz
+
 @echo off
 echo.
 echo.
@@ -0,0 +1,210 @@
+#include <atomic>
+#include <thread>
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include "../../include/PNG/INPUT_FILE.h"
+#include "../../include/PNG/CORPUS_INDEX.h"
+#include "../../include/PNG/Chunks/CHUNK_INDEX.h"
+
+
+/**
+ * @brief Construct a new CORPUS_INDEX::CORPUS_INDEX object, scanning all the png files(.png extension) of a directory tree
+ * @details the directory tree is walked first, then the files are shared between the threads. a file that can't be scanned
+ * is still recorded, with the error reason.
+ *
+ * @param directory the root directory to scan
+ * @param threads the number of scanning threads, 0(default) uses all the logical cores
+ *
+ * @exception std::runtime_error if the directory can't be walked
+ */
+CORPUS_INDEX::CORPUS_INDEX(const std::string &directory, int threads)
+{
+    std::vector<std::string> paths;
+    try
+    {
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied))
+        {
+            if (!entry.is_regular_file())
+                continue;
+
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+            if (extension == ".png")
+                paths.push_back(entry.path().string());
+        }
+    }
+    catch (const std::filesystem::filesystem_error &exception)
+    {
+        throw std::runtime_error("CORPUS_INDEX::CORPUS_INDEX() - Enable to walk the directory \"" + directory + "\" : " + exception.what());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<int>(threads, std::max<std::size_t>(1, paths.size()));
+
+    // each thread takes the next file to scan, so slow files don't hold up the others
+    m_records.resize(paths.size());
+    std::atomic<std::size_t> next(0);
+    auto worker = [this, &paths, &next]()
+    {
+        for (std::size_t i = next++; i < paths.size(); i = next++)
+            m_records[i] = scan(paths[i]);
+    };
+
+    std::vector<std::thread> task_s;
+    for (int i = 0; i < threads; ++i)
+        task_s.emplace_back(worker);
+
+    for (auto &task : task_s) // waiting for all threads to finish
+        task.join();
+}
+
+/**
+ * @brief Destroy the CORPUS_INDEX::CORPUS_INDEX object
+ *
+ */
+CORPUS_INDEX::~CORPUS_INDEX()
+{
+}
+
+/**
+ * @brief get the png files metadatas
+ *
+ * @return const std::vector<CORPUS_INDEX::RECORD>&
+ */
+const std::vector<CORPUS_INDEX::RECORD> &CORPUS_INDEX::get_records() const noexcept
+{
+    return m_records;
+}
+
+/**
+ * @brief method for scanning a single png file
+ * @details the header is checked with PNG::probe(), then the chunks headers are walked, no chunk datas is read.
+ *
+ * @param path the png file path
+ * @return CORPUS_INDEX::RECORD the file metadatas, with the error field set if the file is not a valid png
+ */
+CORPUS_INDEX::RECORD CORPUS_INDEX::scan(const std::string &path)
+{
+    RECORD record;
+    record.path = path;
+    try
+    {
+        INPUT_FILE input(path);
+        record.fileSize = input.get_size();
+
+        std::vector<uint8_t> buffer;
+        if (record.fileSize < 33)
+            throw std::runtime_error("CORPUS_INDEX::scan() - Too short to be a PNG file");
+        record.info = PNG::probe(input.read(0, 33, buffer), 33);
+
+        CHUNK_INDEX chunks(input);
+        for (const auto &entry : chunks.get_entries())
+        {
+            record.chunks.push_back(entry.type);
+            if (entry.type == "IDAT")
+                ++record.IDATCount;
+        }
+    }
+    catch (const std::exception &exception)
+    {
+        record.error = exception.what();
+    }
+    return record;
+}
+
+/**
+ * @brief save the index as a CSV file, one line per png file
+ * @details columns : path, file size, width, height, bit depth, color mode, interlacing, IDAT count, chunks(separated by ';'), error
+ *
+ * @param path the CSV file path
+ *
+ * @exception std::runtime_error if cannot create file as specified path
+ */
+void CORPUS_INDEX::save_csv(const std::string &path) const
+{
+    std::ofstream output_stream(path, std::ios::out | std::ios::binary);
+    if (!output_stream.is_open())
+        throw std::runtime_error("CORPUS_INDEX::save_csv() - Enable to create file at specified path : " + path);
+
+    // quoting a text field, doubling the inner quotes
+    auto quote = [](const std::string &field)
+    {
+        std::string quoted("\"");
+        for (char c : field)
+            quoted += (c == '"') ? std::string("\"\"") : std::string(1, c);
+        return quoted + "\"";
+    };
+
+    output_stream << "path,file_size,width,height,bit_depth,color_mode,interlacing,idat_count,chunks,error\n";
+    for (const auto &record : m_records)
+    {
+        std::string chunks;
+        for (std::size_t i = 0; i < record.chunks.size(); ++i)
+            chunks += (i ? ";" : "") + record.chunks[i];
+
+        output_stream << quote(record.path) << ',' << record.fileSize << ','
+                      << record.info.width << ',' << record.info.height << ','
+                      << +record.info.bitDepth << ',' << +record.info.colorMode << ',' << +record.info.interlacing << ','
+                      << record.IDATCount << ',' << quote(chunks) << ',' << quote(record.error) << '\n';
+    }
+}
+
+/**
+ * @brief save the index as a compact binary file
+ * @details all the integers are big endian(as in png files) :
+ * - header : "PNGX" magic, version(4 bytes), records count(8 bytes)
+ * - each record : path length(2 bytes), path, file size(8 bytes), width(4 bytes), height(4 bytes), bit depth(1 byte),
+ * color mode(1 byte), interlacing(1 byte), IDAT count(4 bytes), chunks count(4 bytes), chunks types(4 bytes each),
+ * error length(2 bytes), error
+ *
+ * @param path the binary file path
+ *
+ * @exception std::runtime_error if cannot create file as specified path
+ */
+void CORPUS_INDEX::save_binary(const std::string &path) const
+{
+    std::ofstream output_stream(path, std::ios::out | std::ios::binary);
+    if (!output_stream.is_open())
+        throw std::runtime_error("CORPUS_INDEX::save_binary() - Enable to create file at specified path : " + path);
+
+    std::string out("PNGX");
+    auto put = [&out](uint64_t value, int bytes) // big endian writing
+    {
+        for (int i = bytes - 1; i >= 0; --i)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    };
+    auto put_text = [&out, &put](const std::string &text)
+    {
+        const std::size_t len = std::min<std::size_t>(text.size(), 0xFFFF);
+        put(len, 2);
+        out.append(text, 0, len);
+    };
+
+    put(1, 4); // version
+    put(m_records.size(), 8);
+    for (const auto &record : m_records)
+    {
+        put_text(record.path);
+        put(record.fileSize, 8);
+        put(static_cast<uint32_t>(record.info.width), 4);
+        put(static_cast<uint32_t>(record.info.height), 4);
+        put(record.info.bitDepth, 1);
+        put(record.info.colorMode, 1);
+        put(record.info.interlacing, 1);
+        put(record.IDATCount, 4);
+        put(record.chunks.size(), 4);
+        for (const auto &type : record.chunks)
+            out += type;
+        put_text(record.error);
+
+        output_stream.write(out.data(), out.size()); // records are written one by one, the index is never entirely built in memory
+        out.clear();
+    }
+    output_stream.write(out.data(), out.size());
+}
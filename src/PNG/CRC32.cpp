@@ -3,7 +3,7 @@
 
 
 bool CRC32::crc_table_computed = false; //static bool for test if the table is already computes or not
-unsigned long CRC32::crc_table[255];    //crc table static var exempt recomputation many crc_table recompution
+unsigned long CRC32::crc_table[256];    //crc table static var exempt recomputation many crc_table recompution
 
 /**
  * @brief crc calculation method
@@ -12,7 +12,7 @@ unsigned long CRC32::crc_table[255];    //crc table static var exempt recomputat
  * @param chunkDatasLen the size of the input buffer (chunkDatas)
  * @return the crc32 calculated
  */
-unsigned long CRC32::getCRC32(uint8_t *chunkDatas, int chunkDatasLen)
+unsigned long CRC32::getCRC32(const uint8_t *chunkDatas, std::size_t chunkDatasLen)
 {
     return CRC32_update(0xffffffffL, chunkDatas, chunkDatasLen) ^ 0xffffffffL;
 }
@@ -42,18 +42,19 @@ void CRC32::CRC32_table_compute()
 
 /**
  * @brief crc32 update method
+ * @note the crc of concatened buffers is computed by updating it buffer after buffer, starting with 0xffffffff(the final value being xored with 0xffffffff)
  * 
- * @param crc 
- * @param dataCHUNK 
- * @param len 
+ * @param crc the actual crc
+ * @param dataCHUNK the next datas
+ * @param len the next datas length
  * @return unsigned long 
  */
-unsigned long CRC32::CRC32_update(unsigned long crc, uint8_t *dataCHUNK, int len)
+unsigned long CRC32::CRC32_update(unsigned long crc, const uint8_t *dataCHUNK, std::size_t len)
 {
-    if (!crc_table_computed)
-        CRC32_table_compute();
-        
-    for (int i = 0; i < len; i++)
+    static const bool table_ready = (CRC32_table_compute(), true); // computed once, thread safe initialisation
+    (void)table_ready;
+
+    for (std::size_t i = 0; i < len; i++)
         crc = crc_table[(crc ^ dataCHUNK[i]) & 0xff] ^ (crc >> 8);
 
     return crc;
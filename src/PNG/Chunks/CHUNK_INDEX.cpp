@@ -0,0 +1,97 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "../../../include/PNG/Chunks/CHUNK_INDEX.h"
+
+
+/**
+ * @brief Construct a new CHUNK_INDEX::CHUNK_INDEX object, walking all the chunks of a png file
+ * @details only the signature and each chunk header(length and type) are read, the chunk datas and crc are skipped,
+ * so the building cost is proportional to the number of chunks, not to the file size.
+ * the walk stops after the IEND chunk or at the end of the file.
+ *
+ * @param input the png input file
+ *
+ * @exception std::runtime_error if the png signature is invalid
+ * @exception std::runtime_error if a chunk is truncated(chunk length goes beyond the end of the file)
+ */
+CHUNK_INDEX::CHUNK_INDEX(INPUT_FILE &input)
+{
+    const uint8_t signature[8] = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+    const uint64_t file_len = input.get_size();
+
+    std::vector<uint8_t> buffer(8);
+    if (file_len < 8 || memcmp(input.read(0, 8, buffer), signature, 8) != 0)
+        throw std::runtime_error("CHUNK_INDEX::CHUNK_INDEX() - Invalid PNG signature");
+
+    uint64_t pos = 8;
+    while (pos + 8 <= file_len)
+    {
+        // reading the chunk header : length(4 bytes) then type(4 bytes)
+        const uint8_t *header = input.read(pos, 8, buffer);
+
+        ENTRY entry;
+        entry.offset = pos + 8;
+        entry.length = static_cast<uint32_t>(header[0]) << 24 | static_cast<uint32_t>(header[1]) << 16 |
+                       static_cast<uint32_t>(header[2]) << 8  | static_cast<uint32_t>(header[3]);
+        entry.type.assign(reinterpret_cast<const char *>(header + 4), 4);
+
+        if (entry.offset + entry.length + 4 > file_len) // datas + crc must fit inside the file
+            throw std::runtime_error("CHUNK_INDEX::CHUNK_INDEX() - Truncated chunk \"" + entry.type + "\"");
+
+        m_entries.push_back(entry);
+        if (entry.type == "IEND")
+            break;
+
+        pos = entry.offset + entry.length + 4; // skipping the datas and the crc, next chunk
+    }
+}
+
+/**
+ * @brief Destroy the CHUNK_INDEX::CHUNK_INDEX object
+ *
+ */
+CHUNK_INDEX::~CHUNK_INDEX()
+{
+}
+
+/**
+ * @brief get all the indexed chunks, in file order
+ *
+ * @return const std::vector<CHUNK_INDEX::ENTRY>&
+ */
+const std::vector<CHUNK_INDEX::ENTRY> &CHUNK_INDEX::get_entries() const noexcept
+{
+    return m_entries;
+}
+
+/**
+ * @brief get the first chunk of a specific type
+ *
+ * @param type the chunk type to search(IHDR, pHYs, ...)
+ * @return either nullptr if there's no such chunk or the chunk entry
+ */
+const CHUNK_INDEX::ENTRY *CHUNK_INDEX::find(const std::string &type) const noexcept
+{
+    for (const auto &entry : m_entries)
+        if (entry.type == type)
+            return &entry;
+
+    return nullptr;
+}
+
+/**
+ * @brief get all the chunks of a specific type, in file order(used for multiples IDAT chunks)
+ *
+ * @param type the chunk type to search
+ * @return a vector including the entries of the specified type
+ */
+std::vector<const CHUNK_INDEX::ENTRY *> CHUNK_INDEX::find_all(const std::string &type) const
+{
+    std::vector<const ENTRY *> entries;
+    for (const auto &entry : m_entries)
+        if (entry.type == type)
+            entries.push_back(&entry);
+
+    return entries;
+}
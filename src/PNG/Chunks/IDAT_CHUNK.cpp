@@ -1,6 +1,9 @@
 
+#include <climits>
+
 #include "../../../include/zlib/zlib.h"
 #include "../../../include/PNG/CRC32.h"
+#include "../../../include/PNG/Filters.h"
 #include "../../../include/PNG/Utilities.h"
 #include "../../../include/PNG/Chunks/IDAT_CHUNK.h"
 
@@ -12,8 +15,12 @@
  * @param s_height png height (according to the pixelsBuffer)
  * @param colorChannel png color channel number
  * @param compress_mode compression mode
+ * @param segment_rows the number of lines of each independently inflatable segment, 0(default) for a single segment
+ * @param strategy the scanlines filter selection strategy, FILTER_STRATEGY::CARDINAL by default
+ *
+ * @exception std::runtime_error if the deflate stream can't be generated
  */
-IDAT_CHUNK::IDAT_CHUNK(const uint8_t *pixelsBuffer, int s_width, int s_height, int colorChannel, int compress_mode)
+IDAT_CHUNK::IDAT_CHUNK(const uint8_t *pixelsBuffer, int s_width, int s_height, int colorChannel, int compress_mode, int segment_rows, const FILTER_STRATEGY &strategy)
 {
     this->m_type = new uint8_t[4]; // setting the IDAT type (IDAT in Hexadecimal)
     this->m_type[0] = 0x49;        // I
@@ -21,12 +28,8 @@ IDAT_CHUNK::IDAT_CHUNK(const uint8_t *pixelsBuffer, int s_width, int s_height, i
     this->m_type[2] = 0x41;        // A
     this->m_type[3] = 0x54;        // T
 
-    m_data = deflate_datas(pixelsBuffer, s_width, s_height, colorChannel, m_length, compress_mode); // getting deflated data output
-
-    // the crc32 calculation algorithm needs the concatened array of the chunk type and the chunk datas
-    uint8_t *dataCRC = Utilities::getConcatenedArray(this->m_type, m_data, 4, m_length);
-    m_crc32 = CRC32::getCRC32(dataCRC, 4 + m_length);
-    delete[] dataCRC;
+    m_segmentRows = segment_rows > 0 ? std::min(segment_rows, s_height) : 0;
+    m_data = deflate_datas(pixelsBuffer, s_width, s_height, colorChannel, m_length, compress_mode, m_segmentRows, strategy); // getting deflated data output
 }
 
 /**
@@ -41,91 +44,135 @@ IDAT_CHUNK::~IDAT_CHUNK()
 
 /**
  * @brief save the actual IDAT_CHUNK datas(type, length, datas, crc32) to a specific output file stream
+ * @details datas longer than MAX_LENGTH are written as consecutive IDAT chunks, decoders inflate their concatenation.
+ * each crc32 is computed on the chunk type then its datas, without concatenating them.
  *
  * @param outputStream the output file stream reference
  */
 void IDAT_CHUNK::save(std::ofstream &outputStream)
 {
-    // we start by converting the (> 1 byte) values into arrays of bytes
-    uint8_t *lengthArrayPtr = Utilities::int_to_uint8(this->m_length);
-    uint8_t *crc32ArrayPtr = Utilities::int_to_uint8(this->m_crc32);
-
-    // then we write chunk datas in the file stream
-    Utilities::stream_write(lengthArrayPtr, 4, outputStream);
-    Utilities::stream_write(this->m_type, 4, outputStream);
-    Utilities::stream_write(this->m_data, this->m_length, outputStream);
-    Utilities::stream_write(crc32ArrayPtr, 4, outputStream);
-
-    delete[] lengthArrayPtr;
-    delete[] crc32ArrayPtr; // freeing the bytes arrays
+    std::size_t written(0);
+    do
+    {
+        const uint32_t length = static_cast<uint32_t>(std::min<std::size_t>(m_length - written, MAX_LENGTH));
+        const unsigned long crc32 = CRC32::CRC32_update(CRC32::CRC32_update(0xffffffffL, this->m_type, 4), this->m_data + written, length) ^ 0xffffffffL;
+
+        // we start by converting the (> 1 byte) values into arrays of bytes
+        uint8_t *lengthArrayPtr = Utilities::int_to_uint8(length);
+        uint8_t *crc32ArrayPtr = Utilities::int_to_uint8(crc32);
+
+        // then we write chunk datas in the file stream
+        Utilities::stream_write(lengthArrayPtr, 4, outputStream);
+        Utilities::stream_write(this->m_type, 4, outputStream);
+        Utilities::stream_write(this->m_data + written, length, outputStream);
+        Utilities::stream_write(crc32ArrayPtr, 4, outputStream);
+
+        delete[] lengthArrayPtr;
+        delete[] crc32ArrayPtr; // freeing the bytes arrays
+        written += length;
+    } while (written < m_length);
 }
 
 /**
  * @brief method for generate scanlines from a specified pixels buffer.
  * @details for image size optimisation, this method is based on a simple way : 
- * for each pixel line, we test all the filtering mode and get the one in which the filtered line has the highest values repetitons(lowest set cardinal).
+ * for each pixel line, we test all the filtering mode and get the one in which the filtered line has the lowest cost for the strategy
+ * (by default the highest values repetitons, lowest set cardinal). each thread selects the filters with its own clone of the strategy.
+ * each thread filters the five candidates at once(see Filters::filter_candidates()) in its own trial lines(allocated once, reused for all
+ * its lines), the selected one is copied in its part of the output scanlines, never filtered again.
+ * when the strategy reuses the previous line filter mode(see FILTER_STRATEGY::get_reused_filter()), only this candidate is evaluated,
+ * the others only if the strategy rejects it(see FILTER_STRATEGY::accept_reused()).
+ * the number of full trials and evaluated candidates is stored in m_trials and m_candidates.
  * @note Now supports multi-threading mode!!
  * @warning case the image height is too small for multi threading supports, the process will be executed in a single thread.
  * @param pixels input pixels buffer
  * @param s_width pixels buffer width
  * @param s_height pixels buffer height
  * @param colorChannel pixels buffer color channel number
+ * @param segment_rows the number of lines of each segment, the first line of a segment is only filtered with None or Sub(0 if not segmented)
+ * @param strategy the filter selection strategy
  * @return uint8_t* output filtered scanline
  */
-uint8_t *IDAT_CHUNK::generate_scanlines(const uint8_t *pixels, int s_width, int s_height, int colorChannel)
+uint8_t *IDAT_CHUNK::generate_scanlines(const uint8_t *pixels, int s_width, int s_height, int colorChannel, int segment_rows, const FILTER_STRATEGY &strategy)
 {        
-    // lambda for generating scanlines...
-    auto generate = [this](const uint8_t *pixels, int s_width, int s_height, int colorChannel, bool is_prev_line) -> uint8_t*
+    const std::size_t lineLength = static_cast<std::size_t>(s_width) * colorChannel;
+
+    // lambda for generating the scanlines of a part of the pixels, in its part of the output
+    auto generate = [segment_rows, &strategy, lineLength](const uint8_t *pixels, uint8_t *scanlines, int s_height, int colorChannel, bool is_prev_line, int first_row,
+                                                          uint64_t *counts) // counts : the full trials and the evaluated candidates
     {
-        uint8_t *scanlines = new uint8_t[s_height * (1 + s_width * colorChannel)]; // output
+        std::unique_ptr<FILTER_STRATEGY> selector = strategy.clone(); // the thread own strategy state
+        const int fixed_filter = selector->get_fixed_filter();
 
-        uint8_t *tmp_filtered_line{nullptr};          // temp filtered lines buffer
-        std::vector<uint8_t> filters_modes(s_height); // lowest computed filters modes
-        for (int i = 1; i <= s_height; ++i)           // testing each filter mode and stores the one with lowest Cardinal.
+        std::vector<uint8_t> trial_lines(fixed_filter >= 0 ? 0 : 5 * lineLength); // a filtered line per filter mode, reused for each line
+        for (int i = 1; i <= s_height; ++i)                                          // testing each filter mode and stores the one with lowest cost.
         {
-            std::vector<int> filterMode_cardinal;
-            for (uint8_t tmp_filter_mode = 0; tmp_filter_mode <= 4; ++tmp_filter_mode)
+            const uint8_t *line = pixels + (i - 1) * lineLength;
+            const bool has_prev_line{(i - 1) != 0 || is_prev_line};
+            uint8_t *scanline = scanlines + (i - 1) * (1 + lineLength);
+
+            // a segment first line must not depend on the previous line(None or Sub), so the segment can be unfiltered alone
+            const bool is_segment_start{segment_rows > 0 && (first_row + i - 1) % segment_rows == 0};
+
+            if (fixed_filter >= 0) // no trial, Up becomes None and Average, Paeth become Sub on a segment first line
             {
-                tmp_filtered_line = filter_line(pixels + (i - 1) * (s_width * colorChannel), // filtering
-                                                s_width * colorChannel,
-                                                tmp_filter_mode,
-                                                (i - 1) == 0 && !is_prev_line ? false : true,
-                                                (i - 1) == 0 && !is_prev_line ? nullptr : pixels + (i - 2) * (s_width * colorChannel),
-                                                colorChannel);
-
-                filterMode_cardinal.push_back(Utilities::get_cardinal(tmp_filtered_line, s_width * colorChannel)); // conputing Cardinal
-                delete[] tmp_filtered_line;
+                scanline[0] = (is_segment_start && fixed_filter > 0x1) ? (fixed_filter == 0x2 ? 0x0 : 0x1) : fixed_filter;
+                Filters::filter_line(line, scanline + 1, static_cast<int>(lineLength), scanline[0], has_prev_line ? line - lineLength : nullptr, colorChannel);
+                continue;
             }
 
-            // storing filter mode with lowest Cardinal
-            auto min = std::min_element(filterMode_cardinal.begin(), filterMode_cardinal.end());
-            filters_modes[i - 1] = min - filterMode_cardinal.begin();
-            filterMode_cardinal.clear();
-        }
+            // the five candidates are filtered in a single pass, with their sums of absolute values
+            uint64_t sads[5];
+            Filters::filter_candidates(line, trial_lines.data(), static_cast<int>(lineLength), has_prev_line ? line - lineLength : nullptr, colorChannel, sads);
+
+            const uint8_t modes = is_segment_start ? 2 : 5; // None and Sub only on a segment first line
+            const uint64_t lowest_sad = *std::min_element(sads, sads + modes);
 
-        uint8_t **filtered_line = new uint8_t* [s_height]; // filtering all pixels lines with the previously stored filters modes
-        for (int i = 1; i <= s_height; i++)
-            memcpy(
-                scanlines + 1 + (i - 1) * (1 + s_width * colorChannel),
-                (filtered_line[i - 1] = filter_line(pixels + (i - 1) * (s_width * colorChannel),
-                                                    s_width * colorChannel, filters_modes[i - 1],
-                                                    (i - 1) == 0 && !is_prev_line ? false : true,
-                                                    (i - 1) == 0 && !is_prev_line ? nullptr : pixels + (i - 2) * (s_width * colorChannel),
-                                                    colorChannel)),
-                s_width * colorChannel);
-
-        // writing filter mode bit in each line.
-        for (int i = 1; i <= s_height; ++i)
-            scanlines[(i - 1) * (1 + s_width * colorChannel)] = filters_modes[i - 1];
-
-        for (int i = 0; i < s_height; i++)
-            delete[] filtered_line[i];
-        filters_modes.clear();
-
-        return scanlines;
+            // the previous line filter mode alone is evaluated, kept if the strategy accepts its cost
+            const int reused_filter = selector->get_reused_filter();
+            const bool is_reused_tried{reused_filter >= 0 && reused_filter < modes};
+            uint64_t reused_cost(0);
+            if (is_reused_tried)
+            {
+                const FILTER_STRATEGY::CANDIDATE reused{static_cast<uint8_t>(reused_filter), trial_lines.data() + reused_filter * lineLength, lineLength, sads[reused_filter]};
+                reused_cost = selector->get_cost(reused);
+                ++counts[1];
+
+                if (selector->accept_reused(reused, reused_cost, lowest_sad))
+                {
+                    scanline[0] = reused.filterMode;
+                    memcpy(scanline + 1, reused.filtered, lineLength);
+                    continue;
+                }
+            }
+
+            uint8_t best_mode(0);
+            uint64_t best_cost(0);
+            for (uint8_t tmp_filter_mode = 0; tmp_filter_mode < modes; ++tmp_filter_mode)
+            {
+                const uint8_t *tmp_filtered_line = trial_lines.data() + tmp_filter_mode * lineLength;
+                const uint64_t cost = (is_reused_tried && tmp_filter_mode == reused_filter) ? reused_cost // already evaluated
+                                                                                             : selector->get_cost({tmp_filter_mode, tmp_filtered_line, lineLength, sads[tmp_filter_mode]}); // computing the cost
+                if (tmp_filter_mode == 0 || cost < best_cost)
+                {
+                    best_mode = tmp_filter_mode;
+                    best_cost = cost;
+                }
+            }
+            ++counts[0];
+            counts[1] += modes - (is_reused_tried ? 1 : 0);
+            if (has_prev_line && !is_segment_start) // a line without predecessor doesn't tell the filter of the next ones
+                selector->set_selected({best_mode, trial_lines.data() + best_mode * lineLength, lineLength, sads[best_mode]}, best_cost, lowest_sad);
+
+            // storing the filter mode with lowest cost, and its filtered line
+            scanline[0] = best_mode;
+            memcpy(scanline + 1, trial_lines.data() + best_mode * lineLength, lineLength);
+        }
     };
 
-    uint8_t *scanlines_out = new uint8_t[s_height * (1 + s_width * colorChannel)]; // output
+    uint8_t *scanlines_out = new uint8_t[s_height * (1 + lineLength)]; // output
+    m_trials = m_candidates = 0;
+
     int thread_number = std::thread::hardware_concurrency(); // getting logical UC avaible on computer
 
     // cause this method separates the input buffer in equals parts(in terms of lines : s_height) for computing,
@@ -145,27 +192,50 @@ uint8_t *IDAT_CHUNK::generate_scanlines(const uint8_t *pixels, int s_width, int
     // case the image height is too small for multi threading supports, 
     // the process will be executed in a single thread.
     if(s_height < eff_threads)
-        return generate(pixels, s_width, s_height, colorChannel, false);
+    {
+        try
+        {
+            uint64_t counts[2] = {0, 0};
+            generate(pixels, scanlines_out, s_height, colorChannel, false, 0, counts);
+            m_trials = counts[0];
+            m_candidates = counts[1];
+        }
+        catch (...)
+        {
+            delete[] scanlines_out;
+            throw;
+        }
+        return scanlines_out;
+    }
 
     // threads related declarations. _s suufix means plural
     std::vector<std::thread> task_s;
-    std::vector<std::future<uint8_t *>> future_s;
-    std::vector<std::promise<uint8_t *>> promise_s(eff_threads);
-
-    std::vector<uint8_t *> result_s; // vector for storing computed results
+    std::vector<std::future<void>> future_s;
+    std::vector<std::promise<void>> promise_s(eff_threads);
+    std::vector<uint64_t> count_s(2 * static_cast<std::size_t>(eff_threads), 0); // trials and candidates of each thread
 
     // lambda for thread creation
-    auto thread_create_s = [&generate](const uint8_t *pixels, int s_width, int s_height, int colorChannel, bool is_prev_line, std::promise<uint8_t *> &p)
+    auto thread_create_s = [&generate](const uint8_t *pixels, uint8_t *scanlines, int s_height, int colorChannel, bool is_prev_line, int first_row, uint64_t *counts,
+                                       std::promise<void> &p)
     {
-        p.set_value(generate(pixels, s_width, s_height, colorChannel, is_prev_line));
+        try
+        {
+            generate(pixels, scanlines, s_height, colorChannel, is_prev_line, first_row, counts);
+            p.set_value();
+        }
+        catch (...) // the error is given back to the calling thread
+        {
+            p.set_exception(std::current_exception());
+        }
     };
 
     int thread_height = s_height / eff_threads;
-    int thread_buff_len{thread_height * s_width * colorChannel};
+    const std::size_t thread_buff_len{static_cast<std::size_t>(thread_height) * lineLength};
 
-    // creating and storing threads in out task list
+    // creating and storing threads in out task list, each one writes its own part of the output
     for (std::size_t i = 0; i < eff_threads; ++i) 
-        task_s.emplace_back(std::thread(thread_create_s, pixels + (i * thread_buff_len), s_width, thread_height, colorChannel, (i == 0) ? false : true, std::ref(promise_s[i])));
+        task_s.emplace_back(std::thread(thread_create_s, pixels + (i * thread_buff_len), scanlines_out + (i * (thread_buff_len + thread_height)),
+                                        thread_height, colorChannel, (i == 0) ? false : true, i * thread_height, count_s.data() + 2 * i, std::ref(promise_s[i])));
     
     int i{0};
     for (i = 0; i < eff_threads; ++i) // futures results for each thread
@@ -174,15 +244,31 @@ uint8_t *IDAT_CHUNK::generate_scanlines(const uint8_t *pixels, int s_width, int
     for (i = 0; i < eff_threads; ++i) // waiting for all threads to finish
         task_s[i].join();
 
-    for (i = 0; i < eff_threads; ++i) // storing results
-        result_s.push_back(future_s[i].get());
+    std::exception_ptr error(nullptr);
+    for (i = 0; i < eff_threads; ++i) // checking results, the first error is thrown once the output is freed
+    {
+        try
+        {
+            future_s[i].get();
+        }
+        catch (...)
+        {
+            if (error == nullptr)
+                error = std::current_exception();
+        }
+    }
 
-    for (i = 0; i < eff_threads; ++i) // copying results to output buffer
-        std::memcpy(scanlines_out + (i * (thread_buff_len + thread_height)), result_s[i], thread_buff_len + thread_height); 
+    if (error != nullptr)
+    {
+        delete[] scanlines_out;
+        std::rethrow_exception(error);
+    }
 
-    for (i = 0; i < eff_threads; ++i) // free results for each thread.
-        delete[] result_s[i];
-    
+    for (i = 0; i < eff_threads; ++i)
+    {
+        m_trials += count_s[2 * i];
+        m_candidates += count_s[2 * i + 1];
+    }
     return scanlines_out;
 }
 
@@ -195,14 +281,22 @@ uint8_t *IDAT_CHUNK::generate_scanlines(const uint8_t *pixels, int s_width, int
  * @param colorChannel the number of color channel in the pixels buffer
  * @param deflatedLen a reference for getting the output defalted length
  * @param compress_mode compression mode
+ * @param segment_rows the number of lines of each segment, 0 for a single segment
+ * @param strategy the scanlines filter selection strategy
  * @return a pointer to the deflated datas buffer
+ * @note when segmented, the deflate stream is fully flushed after each segment : the next segment starts byte aligned,
+ * with an empty history, and can be inflated alone(as a raw deflate stream). the segments positions are stored in m_segmentOffsets.
+ *
+ * @exception std::runtime_error if the deflate stream can't be generated
  */
-uint8_t *IDAT_CHUNK::deflate_datas(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel, int &deflatedLen, int compress_mode)
+uint8_t *IDAT_CHUNK::deflate_datas(const uint8_t *pixelBuffer, int s_width, int s_height, int colorChannel, std::size_t &deflatedLen, int compress_mode, int segment_rows, const FILTER_STRATEGY &strategy)
 {
-    unsigned long inLen = s_height * (1 + s_width * colorChannel), tmpLen = 0;            // input len of scanlines datas
-    uint8_t *scanlines = generate_scanlines(pixelBuffer, s_width, s_height, colorChannel); // generating scanlines from the pixels
+    const std::size_t lineLen = 1 + static_cast<std::size_t>(s_width) * colorChannel;                  // scanline length, with the filter byte
+    const std::size_t inLen = s_height * lineLen;                                                       // input len of scanlines datas
+    uint8_t *scanlines = generate_scanlines(pixelBuffer, s_width, s_height, colorChannel, segment_rows, strategy); // generating scanlines from the pixels
 
     uint8_t *deflatedDatas = nullptr; // setting up the deflated datas output
+    std::size_t capacity(0), written(0);
     int result = 0;
 
     // initialising zlib
@@ -210,119 +304,66 @@ uint8_t *IDAT_CHUNK::deflate_datas(const uint8_t *pixelBuffer, int s_width, int
     defstream.zalloc = Z_NULL;
     defstream.zfree = Z_NULL;
     defstream.opaque = Z_NULL;
-    defstream.avail_in = inLen;
-    defstream.next_in = (Bytef *)scanlines;
+    defstream.avail_in = 0;
+    defstream.next_in = Z_NULL;
     defstream.avail_out = 0;
-    defstream.next_out = (Bytef *)deflatedDatas;
+    defstream.next_out = Z_NULL;
 
     if ((result = deflateInit(&defstream, compress_mode)) == Z_OK)
     {
-        // calculate the actual length and update zlib structure
-        unsigned long estimateLen = deflateBound(&defstream, inLen);
-        deflatedDatas = new uint8_t[estimateLen];
-        if (deflatedDatas != nullptr)
+        // calculate the estimated length(deflateBound() takes an uLong, 32 bits on some platforms),
+        // each full flush adds at most an ending block and an empty stored block(16 bytes is a safe bound)
+        const std::size_t segments = segment_rows > 0 ? (s_height + segment_rows - 1) / segment_rows : 1;
+        capacity = (inLen <= ULONG_MAX ? deflateBound(&defstream, static_cast<uLong>(inLen)) : inLen + inLen / 1000 + 64) + (segments - 1) * 16;
+        deflatedDatas = new uint8_t[capacity];
+
+        // do the compression, segment by segment. avail_in and avail_out are uInt(32 bits),
+        // so bigger buffers are given to zlib by parts, and the output grows if the estimation was too short
+        m_segmentOffsets.clear();
+        for (int row = 0; row < s_height && (result == Z_OK); row += (segment_rows > 0 ? segment_rows : s_height))
         {
-            // updation zlib configuration
-            defstream.avail_out = (uInt)estimateLen;
-            defstream.next_out = (Bytef *)deflatedDatas;
-
-            // do the compression
-            deflate(&defstream, Z_FINISH);
-            tmpLen = (uint8_t *)defstream.next_out - deflatedDatas;
+            const int rows = segment_rows > 0 ? std::min(segment_rows, s_height - row) : s_height;
+            const int flush = row + rows == s_height ? Z_FINISH : Z_FULL_FLUSH;
+            if (segment_rows > 0)
+                m_segmentOffsets.push_back(written);
+
+            const uint8_t *in = scanlines + row * lineLen;
+            std::size_t remaining = rows * lineLen;
+            do
+            {
+                if (written == capacity)
+                {
+                    uint8_t *grown = new uint8_t[capacity + capacity / 2];
+                    memcpy(grown, deflatedDatas, written);
+                    delete[] deflatedDatas;
+                    deflatedDatas = grown;
+                    capacity += capacity / 2;
+                }
+
+                const uInt in_part = static_cast<uInt>(std::min<std::size_t>(remaining, UINT_MAX));
+                const uInt out_part = static_cast<uInt>(std::min<std::size_t>(capacity - written, UINT_MAX));
+                defstream.next_in = (Bytef *)in;
+                defstream.avail_in = in_part;
+                defstream.next_out = (Bytef *)deflatedDatas + written;
+                defstream.avail_out = out_part;
+
+                result = deflate(&defstream, remaining == in_part ? flush : Z_NO_FLUSH);
+
+                in += in_part - defstream.avail_in;
+                remaining -= in_part - defstream.avail_in;
+                written += out_part - defstream.avail_out;
+            } while (result == Z_OK && (remaining > 0 || defstream.avail_out == 0 || flush == Z_FINISH)); // a flush is complete when output space is left
         }
     }
     deflateEnd(&defstream); // end of deflating algorithm
-    deflatedLen = tmpLen;   // copying the deflated data length to the IDAT->length attribut
+    deflatedLen = written;  // copying the deflated data length to the IDAT->length attribut
     delete[] scanlines;
 
-    return deflatedDatas;
-}
-
-/**
- * @brief filtering line method
- * @details png format has many filtering options for improving the compression(deflate)
- * then after decompression(inflate), datas needs to be unfiltered, according to the specified filter method
- * @note filtering and unfiltering methods are applied one each line.
- *
- * @param line_in the input line to unfilter
- * @param lineLength the input line length
- * @param filterMode the filter mode of the actual line ( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)
- * @param is_prev_line if the actual line have a predecessor line
- * @param unfiltered_prev_line the predecessor line (no filtered)
- * @param colorChannel the number of color channel of the input line
- * @return uint8_t* filtered line
- *
- * @exception std::bad_alloc case filtered line memory allocation failed
- * @exception std::invalid_argument case Invalid filter mode
- */
-uint8_t *IDAT_CHUNK::filter_line(const uint8_t *line_in, int lineLength, uint8_t filterMode, bool is_prev_line, const uint8_t *unfiltered_prev_line, uint8_t colorChannel)
-{
-    int i(0);
-    uint8_t *line_out = new uint8_t[lineLength]; // unfiltered output buffer
-    if (!line_out)
-        throw std::bad_alloc();
-
-    switch (filterMode)
+    if (result != Z_STREAM_END)
     {
-    case 0x0: // filter mode 0(none), output buffer is the same as the in buffer
-        memcpy(line_out, line_in, lineLength);
-        break;
-
-    case 0x1: // filter mode 1(Sub),
-        memcpy(line_out, line_in, colorChannel);
-
-        for (i = colorChannel; i < lineLength; i++)
-            line_out[i] = (uint8_t)(line_in[i] - line_in[i - colorChannel]);
-        break;
-
-    case 0x2: // filter mode 2(Up)
-        if (!is_prev_line)
-            memcpy(line_out, line_in, lineLength);
-
-        else
-            for (i = 0; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] - unfiltered_prev_line[i]);
-        break;
-
-    case 0x3: // filter mode 3(Average)
-        if (!is_prev_line)
-        {
-            memcpy(line_out, line_in, colorChannel);
-
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] - floor((line_in[i - colorChannel]) / 2));
-        }
-        else
-        {
-            for (i = 0; i < colorChannel; i++)
-                line_out[i] = (uint8_t)(line_in[i] - (floor((unfiltered_prev_line[i]) / 2)));
-
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] - floor((line_in[i - colorChannel] + unfiltered_prev_line[i]) / 2));
-        }
-        break;
-
-    case 0x4: // filter mode 4(Paeth)
-        if (!is_prev_line)
-        {
-            memcpy(line_out, line_in, colorChannel);
-
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] - Utilities::paeth_predictor(line_in[i - colorChannel], 0, 0));
-        }
-        else
-        {
-            for (i = 0; i < colorChannel; i++)
-                line_out[i] = (uint8_t)(line_in[i] - unfiltered_prev_line[i]);
-
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] - Utilities::paeth_predictor(line_in[i - colorChannel], unfiltered_prev_line[i], unfiltered_prev_line[i - colorChannel]));
-        }
-        break;
-
-    default:
-        throw std::invalid_argument("Invalid filter mode is specified : 0x" + std::to_string(filterMode));
-        break;
+        delete[] deflatedDatas;
+        throw std::runtime_error("IDAT_CHUNK::deflate_datas() - Enable to deflate the scanlines, zlib error " + std::to_string(result));
     }
-    return line_out;
+
+    return deflatedDatas;
 }
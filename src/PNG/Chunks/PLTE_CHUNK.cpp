@@ -0,0 +1,75 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "../../../include/PNG/CRC32.h"
+#include "../../../include/PNG/Utilities.h"
+#include "../../../include/PNG/Chunks/PLTE_CHUNK.h"
+
+
+/**
+ * @brief Construct a new PLTE_CHUNK::PLTE_CHUNK object, from the chunk datas of a png file
+ *
+ * @param datas the palette entries, 3 bytes(RGB) each
+ * @param length the chunk datas length
+ *
+ * @exception std::runtime_error if the length is not a multiple of 3 or is not between 1 and 256 entries
+ */
+PLTE_CHUNK::PLTE_CHUNK(const uint8_t *datas, uint32_t length)
+{
+    if (length == 0 || length % 3 != 0 || length > 3 * 256)
+        throw std::runtime_error("PLTE_CHUNK::PLTE_CHUNK() - Invalid PLTE chunk length");
+
+    this->m_type = new uint8_t[4];       // setting up  the PLTE type (PLTE in Hexadecimal)
+    this->m_type[0] = 0x50; //P
+    this->m_type[1] = 0x4C; //L
+    this->m_type[2] = 0x54; //T
+    this->m_type[3] = 0x45; //E
+
+    m_entries.assign(datas, datas + length);
+    m_length = static_cast<int>(length);
+
+    //the crc32 calculation algorithm needs the concatened array of the chunk type and the chunk datas
+    std::vector<uint8_t> dataCRC(this->m_type, this->m_type + 4);
+    dataCRC.insert(dataCRC.end(), m_entries.begin(), m_entries.end());
+
+    m_crc32 = CRC32::getCRC32(dataCRC.data(), dataCRC.size());
+}
+
+/**
+ * @brief Destroy the PLTE_CHUNK::PLTE_CHUNK object
+ *
+ */
+PLTE_CHUNK::~PLTE_CHUNK()
+{
+    delete[] this->m_type;
+}
+
+/**
+ * @brief get the number of palette entries
+ *
+ * @return int, 1 to 256
+ */
+int PLTE_CHUNK::get_entries_count() const noexcept
+{
+    return static_cast<int>(m_entries.size() / 3);
+}
+
+/**
+ * @brief save the actual PLTE_CHUNK datas(type, length, datas, crc32) to an output file stream
+ *
+ * @param outputStream the output file stream reference
+ */
+void PLTE_CHUNK::save(std::ofstream &outputStream)
+{
+    //we start by converting the (> 1 byte) values into arrays of bytes
+    uint8_t *lengthArrayPtr = Utilities::int_to_uint8(m_length);
+    uint8_t *crc32ArrayPtr = Utilities::int_to_uint8(m_crc32);
+
+    //then we write chunk datas in the file stream
+    Utilities::stream_write(lengthArrayPtr, 4, outputStream);
+    Utilities::stream_write(this->m_type, 4, outputStream);
+    Utilities::stream_write(m_entries.data(), m_entries.size(), outputStream);
+    Utilities::stream_write(crc32ArrayPtr, 4, outputStream);
+
+    delete[] lengthArrayPtr;    delete[] crc32ArrayPtr; //freeing the bytes arrays
+}
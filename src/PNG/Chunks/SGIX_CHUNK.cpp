@@ -0,0 +1,116 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "../../../include/PNG/CRC32.h"
+#include "../../../include/PNG/Utilities.h"
+#include "../../../include/PNG/Chunks/SGIX_CHUNK.h"
+
+
+/**
+ * @brief Construct a new SGIX_CHUNK::SGIX_CHUNK object
+ *
+ * @param rowsPerSegment the number of lines of each segment
+ * @param offsets the position of each segment in the deflate stream
+ */
+SGIX_CHUNK::SGIX_CHUNK(uint32_t rowsPerSegment, const std::vector<uint64_t> &offsets)
+{
+    this->m_type = new uint8_t[4];       // setting up  the sgIX type (sgIX in Hexadecimal)
+    this->m_type[0] = 0x73; //s
+    this->m_type[1] = 0x67; //g
+    this->m_type[2] = 0x49; //I
+    this->m_type[3] = 0x58; //X
+
+    m_rowsPerSegment = rowsPerSegment;
+    m_offsets = offsets;
+    m_length = static_cast<int>(4 + 8 * m_offsets.size());
+
+    //the crc32 calculation algorithm needs the concatened array of the chunk type and the chunk datas
+    std::vector<uint8_t> dataCRC(this->m_type, this->m_type + 4);
+    const std::vector<uint8_t> datas = get_datas();
+    dataCRC.insert(dataCRC.end(), datas.begin(), datas.end());
+
+    m_crc32 = CRC32::getCRC32(dataCRC.data(), static_cast<int>(dataCRC.size()));
+}
+
+/**
+ * @brief Construct a new SGIX_CHUNK::SGIX_CHUNK object, parsing the chunk datas of a png file
+ *
+ * @param datas the chunk datas
+ * @param length the chunk datas length
+ *
+ * @exception std::runtime_error if the datas are not a valid segments index
+ */
+SGIX_CHUNK::SGIX_CHUNK(const uint8_t *datas, uint32_t length) : SGIX_CHUNK(0, std::vector<uint64_t>())
+{
+    if (length < 4 + 8 || (length - 4) % 8 != 0)
+        throw std::runtime_error("SGIX_CHUNK::SGIX_CHUNK() - Invalid sgIX chunk length");
+
+    auto read = [datas](uint32_t pos, int bytes) // big endian reading
+    {
+        uint64_t value(0);
+        for (int i = 0; i < bytes; ++i)
+            value = value << 8 | datas[pos + i];
+        return value;
+    };
+
+    m_rowsPerSegment = static_cast<uint32_t>(read(0, 4));
+    for (uint32_t pos = 4; pos < length; pos += 8)
+        m_offsets.push_back(read(pos, 8));
+
+    if (m_rowsPerSegment == 0 || m_offsets.front() != 0)
+        throw std::runtime_error("SGIX_CHUNK::SGIX_CHUNK() - Invalid sgIX chunk datas");
+
+    for (std::size_t i = 1; i < m_offsets.size(); ++i)
+        if (m_offsets[i] <= m_offsets[i - 1])
+            throw std::runtime_error("SGIX_CHUNK::SGIX_CHUNK() - Invalid sgIX chunk datas");
+
+    m_length = static_cast<int>(length);
+}
+
+/**
+ * @brief Destroy the SGIX_CHUNK::SGIX_CHUNK object
+ *
+ */
+SGIX_CHUNK::~SGIX_CHUNK()
+{
+    delete[] this->m_type;
+}
+
+/**
+ * @brief get the chunk datas, big endian
+ *
+ * @return std::vector<uint8_t>
+ */
+std::vector<uint8_t> SGIX_CHUNK::get_datas() const
+{
+    std::vector<uint8_t> datas;
+    for (int i = 3; i >= 0; --i)
+        datas.push_back(static_cast<uint8_t>(m_rowsPerSegment >> (8 * i)));
+
+    for (uint64_t offset : m_offsets)
+        for (int i = 7; i >= 0; --i)
+            datas.push_back(static_cast<uint8_t>(offset >> (8 * i)));
+
+    return datas;
+}
+
+/**
+ * @brief save the actual SGIX_CHUNK datas(type, length, datas, crc32) to an output file stream
+ *
+ * @param outputStream the output file stream reference
+ */
+void SGIX_CHUNK::save(std::ofstream &outputStream)
+{
+    //we start by converting the (> 1 byte) values into arrays of bytes
+    uint8_t *lengthArrayPtr = Utilities::int_to_uint8(m_length);
+    uint8_t *crc32ArrayPtr = Utilities::int_to_uint8(m_crc32);
+    const std::vector<uint8_t> datas = get_datas();
+
+    //then we write chunk datas in the file stream
+    Utilities::stream_write(lengthArrayPtr, 4, outputStream);
+    Utilities::stream_write(this->m_type, 4, outputStream);
+    Utilities::stream_write(datas.data(), static_cast<int>(datas.size()), outputStream);
+    Utilities::stream_write(crc32ArrayPtr, 4, outputStream);
+
+    delete[] lengthArrayPtr;    delete[] crc32ArrayPtr; //freeing the bytes arrays
+}
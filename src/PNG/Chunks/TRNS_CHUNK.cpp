@@ -0,0 +1,66 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "../../../include/PNG/CRC32.h"
+#include "../../../include/PNG/Utilities.h"
+#include "../../../include/PNG/Chunks/TRNS_CHUNK.h"
+
+
+/**
+ * @brief Construct a new TRNS_CHUNK::TRNS_CHUNK object, from the chunk datas of a png file
+ * @note the length is checked against the color mode by the png decoding, see PNG::PNG().
+ *
+ * @param datas the transparency datas
+ * @param length the chunk datas length
+ *
+ * @exception std::runtime_error if the length is longer than a full palette(256 bytes)
+ */
+TRNS_CHUNK::TRNS_CHUNK(const uint8_t *datas, uint32_t length)
+{
+    if (length > 256)
+        throw std::runtime_error("TRNS_CHUNK::TRNS_CHUNK() - Invalid tRNS chunk length");
+
+    this->m_type = new uint8_t[4];       // setting up  the tRNS type (tRNS in Hexadecimal)
+    this->m_type[0] = 0x74; //t
+    this->m_type[1] = 0x52; //R
+    this->m_type[2] = 0x4E; //N
+    this->m_type[3] = 0x53; //S
+
+    m_datas.assign(datas, datas + length);
+    m_length = static_cast<int>(length);
+
+    //the crc32 calculation algorithm needs the concatened array of the chunk type and the chunk datas
+    std::vector<uint8_t> dataCRC(this->m_type, this->m_type + 4);
+    dataCRC.insert(dataCRC.end(), m_datas.begin(), m_datas.end());
+
+    m_crc32 = CRC32::getCRC32(dataCRC.data(), dataCRC.size());
+}
+
+/**
+ * @brief Destroy the TRNS_CHUNK::TRNS_CHUNK object
+ *
+ */
+TRNS_CHUNK::~TRNS_CHUNK()
+{
+    delete[] this->m_type;
+}
+
+/**
+ * @brief save the actual TRNS_CHUNK datas(type, length, datas, crc32) to an output file stream
+ *
+ * @param outputStream the output file stream reference
+ */
+void TRNS_CHUNK::save(std::ofstream &outputStream)
+{
+    //we start by converting the (> 1 byte) values into arrays of bytes
+    uint8_t *lengthArrayPtr = Utilities::int_to_uint8(m_length);
+    uint8_t *crc32ArrayPtr = Utilities::int_to_uint8(m_crc32);
+
+    //then we write chunk datas in the file stream
+    Utilities::stream_write(lengthArrayPtr, 4, outputStream);
+    Utilities::stream_write(this->m_type, 4, outputStream);
+    Utilities::stream_write(m_datas.data(), m_datas.size(), outputStream);
+    Utilities::stream_write(crc32ArrayPtr, 4, outputStream);
+
+    delete[] lengthArrayPtr;    delete[] crc32ArrayPtr; //freeing the bytes arrays
+}
@@ -0,0 +1,347 @@
+#include <cmath>
+#include <string>
+#include <stdexcept>
+
+#include "../../include/PNG/Utilities.h"
+#include "../../include/PNG/FILTER_STRATEGY.h"
+
+
+/**
+ * @brief get the filter mode forced for all the lines
+ *
+ * @return int, the filter mode or -1 if the candidates are tried(default)
+ */
+int FILTER_STRATEGY::get_fixed_filter() const noexcept
+{
+    return -1;
+}
+
+/**
+ * @brief get the filter mode to try alone on the next line, before any full trial
+ *
+ * @return int, the filter mode or -1 for a full trial(default)
+ */
+int FILTER_STRATEGY::get_reused_filter() const noexcept
+{
+    return -1;
+}
+
+/**
+ * @brief if the filter mode given by get_reused_filter() is kept for the line, else the other candidates are evaluated
+ *
+ * @param candidate the line filtered with the reused filter mode
+ * @param cost the candidate cost
+ * @param lowest_sad the lowest sum of absolute values of the line candidates
+ * @return bool, true(default)
+ */
+bool FILTER_STRATEGY::accept_reused(const CANDIDATE &, uint64_t, uint64_t)
+{
+    return true;
+}
+
+/**
+ * @brief notification of the filter mode selected by a full trial
+ *
+ * @param candidate the selected candidate
+ * @param cost the selected candidate cost
+ * @param lowest_sad the lowest sum of absolute values of the line candidates
+ */
+void FILTER_STRATEGY::set_selected(const CANDIDATE &, uint64_t, uint64_t)
+{
+}
+
+/**
+ * @brief Construct a new FILTER_STRATEGY::FIXED object
+ *
+ * @param filterMode the filter mode of all the lines( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)
+ *
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+FILTER_STRATEGY::FIXED::FIXED(int filterMode) : m_filterMode(filterMode)
+{
+    if (filterMode < 0x0 || filterMode > 0x4)
+        throw std::invalid_argument("FILTER_STRATEGY::FIXED::FIXED() - Invalid filter mode is specified : " + std::to_string(filterMode));
+}
+
+/**
+ * @brief get the filter mode forced for all the lines
+ *
+ * @return int, the filter mode
+ */
+int FILTER_STRATEGY::FIXED::get_fixed_filter() const noexcept
+{
+    return m_filterMode;
+}
+
+/**
+ * @brief get the cost of a candidate, all the candidates are equal(the fixed filter mode is never tried)
+ *
+ * @return uint64_t, 0
+ */
+uint64_t FILTER_STRATEGY::FIXED::get_cost(const CANDIDATE &)
+{
+    return 0;
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::FIXED::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new FIXED(*this));
+}
+
+/**
+ * @brief get the cost of a candidate, the number of distinct bytes of the filtered line
+ *
+ * @param candidate the filtered line
+ * @return uint64_t, 0 to 256
+ */
+uint64_t FILTER_STRATEGY::CARDINAL::get_cost(const CANDIDATE &candidate)
+{
+    return Utilities::get_cardinal(candidate.filtered, candidate.length);
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::CARDINAL::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new CARDINAL(*this));
+}
+
+/**
+ * @brief get the cost of a candidate, the sum of the filtered bytes absolute values(as signed bytes)
+ *
+ * @param candidate the filtered line
+ * @return uint64_t
+ */
+uint64_t FILTER_STRATEGY::SAD::get_cost(const CANDIDATE &candidate)
+{
+    return candidate.sad; // already summed by the filtering kernel
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::SAD::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new SAD(*this));
+}
+
+/**
+ * @brief get the cost of a candidate, the filtered line entropy : - sum(count * log2(count / length)) bits
+ *
+ * @param candidate the filtered line
+ * @return uint64_t, the entropy in 1/256 bits
+ */
+uint64_t FILTER_STRATEGY::ENTROPY::get_cost(const CANDIDATE &candidate)
+{
+    uint32_t histogram[256];
+    Utilities::get_histogram(candidate.filtered, candidate.length, histogram);
+
+    double bits(0.0);
+    const double length = static_cast<double>(candidate.length);
+    for (uint32_t count : histogram)
+        if (count > 0)
+            bits -= count * std::log2(count / length);
+
+    return static_cast<uint64_t>(bits * 256.0 + 0.5);
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::ENTROPY::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new ENTROPY(*this));
+}
+
+/**
+ * @brief Construct a new FILTER_STRATEGY::DEFLATE object
+ * @note the deflate stream is initialised at the first trial, by each clone.
+ *
+ * @param level the zlib compression level of the trials, Z_BEST_SPEED(default) to Z_BEST_COMPRESSION
+ *
+ * @exception std::invalid_argument if the compression level is invalid
+ */
+FILTER_STRATEGY::DEFLATE::DEFLATE(int level) : m_level(level)
+{
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+        throw std::invalid_argument("FILTER_STRATEGY::DEFLATE::DEFLATE() - Invalid compression level : " + std::to_string(level));
+}
+
+/**
+ * @brief Construct a new FILTER_STRATEGY::DEFLATE object (by copy), the copy has its own deflate stream
+ *
+ * @param strategy object to be copied
+ */
+FILTER_STRATEGY::DEFLATE::DEFLATE(const DEFLATE &strategy) : FILTER_STRATEGY(), m_level(strategy.m_level)
+{
+}
+
+/**
+ * @brief Destroy the FILTER_STRATEGY::DEFLATE object
+ *
+ */
+FILTER_STRATEGY::DEFLATE::~DEFLATE()
+{
+    if (m_initialised)
+        deflateEnd(&m_stream);
+}
+
+/**
+ * @brief get the cost of a candidate, the length of the filtered line deflated alone
+ *
+ * @param candidate the filtered line
+ * @return uint64_t, the deflated length in bytes
+ *
+ * @exception std::runtime_error if the line can't be deflated
+ */
+uint64_t FILTER_STRATEGY::DEFLATE::get_cost(const CANDIDATE &candidate)
+{
+    if (!m_initialised)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        if (deflateInit(&m_stream, m_level) != Z_OK)
+            throw std::runtime_error("FILTER_STRATEGY::DEFLATE::get_cost() - zlib initialisation failed");
+        m_initialised = true;
+    }
+    else
+        deflateReset(&m_stream);
+
+    // a line is shorter than INT_MAX bytes(see Utilities::get_buffer_length()), it's deflated at once
+    m_output.resize(deflateBound(&m_stream, static_cast<uLong>(candidate.length)));
+    m_stream.next_in = (Bytef *)candidate.filtered;
+    m_stream.avail_in = static_cast<uInt>(candidate.length);
+    m_stream.next_out = (Bytef *)m_output.data();
+    m_stream.avail_out = static_cast<uInt>(m_output.size());
+
+    const int result = deflate(&m_stream, Z_FINISH);
+    if (result != Z_STREAM_END)
+        throw std::runtime_error("FILTER_STRATEGY::DEFLATE::get_cost() - Enable to deflate the line, zlib error " + std::to_string(result));
+
+    return m_stream.total_out;
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::DEFLATE::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new DEFLATE(*this));
+}
+
+/**
+ * @brief Construct a new FILTER_STRATEGY::ADAPTIVE object
+ *
+ * @param strategy the strategy giving the costs, CARDINAL by default
+ * @param period the maximum number of lines between two full trials, 16 by default
+ * @param tolerance the accepted cost excess of the reused filter mode over the estimate, 0.05(5%) by default
+ *
+ * @exception std::invalid_argument if the period is lower than 1 or the tolerance is negative
+ */
+FILTER_STRATEGY::ADAPTIVE::ADAPTIVE(const FILTER_STRATEGY &strategy, int period, double tolerance) : m_strategy(strategy.clone()), m_period(period), m_tolerance(tolerance)
+{
+    if (period < 1)
+        throw std::invalid_argument("FILTER_STRATEGY::ADAPTIVE::ADAPTIVE() - Invalid period : " + std::to_string(period));
+    if (!(tolerance >= 0.0))
+        throw std::invalid_argument("FILTER_STRATEGY::ADAPTIVE::ADAPTIVE() - Invalid tolerance : " + std::to_string(tolerance));
+}
+
+/**
+ * @brief Construct a new FILTER_STRATEGY::ADAPTIVE object (by copy), the copy has its own strategy clone and starts with a full trial
+ *
+ * @param strategy object to be copied
+ */
+FILTER_STRATEGY::ADAPTIVE::ADAPTIVE(const ADAPTIVE &strategy) : FILTER_STRATEGY(), m_strategy(strategy.m_strategy->clone()),
+                                                                  m_period(strategy.m_period), m_tolerance(strategy.m_tolerance)
+{
+}
+
+/**
+ * @brief get the filter mode forced for all the lines, the one of the strategy
+ *
+ * @return int, the filter mode or -1 if the candidates are tried
+ */
+int FILTER_STRATEGY::ADAPTIVE::get_fixed_filter() const noexcept
+{
+    return m_strategy->get_fixed_filter();
+}
+
+/**
+ * @brief get the filter mode to try alone on the next line, the one of the last full trial
+ *
+ * @return int, the filter mode or -1 for a full trial(first line or period reached)
+ */
+int FILTER_STRATEGY::ADAPTIVE::get_reused_filter() const noexcept
+{
+    return m_reusedLines < m_period - 1 ? m_filterMode : -1;
+}
+
+/**
+ * @brief if the reused filter mode is kept for the line, its cost being close enough to the estimate(then updated)
+ * and its sum of absolute values not exceeding the lowest one more than at the last full trial
+ *
+ * @param candidate the line filtered with the reused filter mode
+ * @param cost the candidate cost
+ * @param lowest_sad the lowest sum of absolute values of the line candidates
+ * @return bool
+ */
+bool FILTER_STRATEGY::ADAPTIVE::accept_reused(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad)
+{
+    if (cost > m_estimate * (1.0 + m_tolerance) || candidate.sad + 1.0 > m_excess * (lowest_sad + 1.0) * (1.0 + m_tolerance))
+        return false;
+
+    m_estimate += (cost - m_estimate) / 4.0; // following slow drifts, a full trial is done on sudden ones
+    ++m_reusedLines;
+    return true;
+}
+
+/**
+ * @brief notification of the filter mode selected by a full trial, reused on the next lines
+ *
+ * @param candidate the selected candidate
+ * @param cost the selected candidate cost, the new estimate
+ * @param lowest_sad the lowest sum of absolute values of the line candidates
+ */
+void FILTER_STRATEGY::ADAPTIVE::set_selected(const CANDIDATE &candidate, uint64_t cost, uint64_t lowest_sad)
+{
+    m_filterMode = candidate.filterMode;
+    m_estimate = static_cast<double>(cost);
+    m_excess = (candidate.sad + 1.0) / (lowest_sad + 1.0);
+    m_reusedLines = 0;
+}
+
+/**
+ * @brief get the cost of a candidate, given by the strategy
+ *
+ * @param candidate the filtered line
+ * @return uint64_t
+ */
+uint64_t FILTER_STRATEGY::ADAPTIVE::get_cost(const CANDIDATE &candidate)
+{
+    return m_strategy->get_cost(candidate);
+}
+
+/**
+ * @brief get a copy of the strategy, for an encoding thread
+ *
+ * @return std::unique_ptr<FILTER_STRATEGY>
+ */
+std::unique_ptr<FILTER_STRATEGY> FILTER_STRATEGY::ADAPTIVE::clone() const
+{
+    return std::unique_ptr<FILTER_STRATEGY>(new ADAPTIVE(*this));
+}
@@ -0,0 +1,681 @@
+#include <array>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../../include/PNG/Filters.h"
+#include "../../include/PNG/Utilities.h"
+
+// x86 SIMD kernels, compiled for their own instruction set and selected at runtime(the rest of the library stays generic)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define FILTERS_X86
+    #include <immintrin.h>
+
+    #define FILTERS_SSE2 __attribute__((target("sse2")))
+    #define FILTERS_SSSE3 __attribute__((target("ssse3")))
+    #define FILTERS_AVX2 __attribute__((target("avx2")))
+#endif
+
+
+/** unfiltering kernel of a filter mode, for a line of whole pixels*/
+typedef void (*KERNEL)(uint8_t *line, int lineLength, const uint8_t *unfiltered_prev_line);
+
+/** filtering kernel computing the five filtered candidates of a line, and their sums of absolute values*/
+typedef void (*CANDIDATES_KERNEL)(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *prev, int bpp, uint64_t *sads);
+
+/** the unfiltering kernels of a pixel size*/
+struct KERNELS
+{
+    KERNEL sub = nullptr;
+    KERNEL up = nullptr;
+    KERNEL average = nullptr;
+    KERNEL paeth = nullptr;
+};
+
+/**
+ * @brief paeth predictor, inlined version of Utilities::paeth_predictor
+ *
+ */
+static inline int paeth(int left, int up, int upperLeft)
+{
+    const int p_left = abs(up - upperLeft), p_up = abs(left - upperLeft), p_upperLeft = abs(left + up - 2 * upperLeft);
+    return (p_left <= p_up && p_left <= p_upperLeft) ? left : (p_up <= p_upperLeft ? up : upperLeft);
+}
+
+/**
+ * @brief scalar kernels, the pixel size being a constant the compiler unrolls the inner loops
+ *
+ */
+template <int bpp>
+static void sub_scalar(uint8_t *line, int lineLength, const uint8_t *)
+{
+    for (int i = bpp; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + line[i - bpp]);
+}
+
+static void up_scalar(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    for (int i = 0; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + prev[i]);
+}
+
+template <int bpp>
+static void average_scalar(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    for (int i = 0; i < bpp; i++)
+        line[i] = (uint8_t)(line[i] + (prev[i] >> 1));
+
+    for (int i = bpp; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + ((line[i - bpp] + prev[i]) >> 1));
+}
+
+template <int bpp>
+static void paeth_scalar(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    for (int i = 0; i < bpp; i++)
+        line[i] = (uint8_t)(line[i] + prev[i]);
+
+    for (int i = bpp; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + paeth(line[i - bpp], prev[i], prev[i - bpp]));
+}
+
+/**
+ * @brief absolute value of a filtered byte, as a signed byte
+ *
+ */
+static inline int sad_byte(uint8_t value)
+{
+    return value < 0x80 ? value : 0x100 - value;
+}
+
+/**
+ * @brief the five filtered candidates of the bytes first to last - 1 of a line, the predecessor line may be nullptr(zeros)
+ * @note the candidate of filter mode m is stored at candidates + m * lineLength.
+ */
+static void candidates_range(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *prev, int bpp, uint64_t *sads, int first, int last)
+{
+    for (int i = first; i < last; i++)
+    {
+        const int a = i >= bpp ? line[i - bpp] : 0, b = prev != nullptr ? prev[i] : 0, c = (prev != nullptr && i >= bpp) ? prev[i - bpp] : 0;
+        const uint8_t out[5] = {line[i], (uint8_t)(line[i] - a), (uint8_t)(line[i] - b), (uint8_t)(line[i] - ((a + b) >> 1)), (uint8_t)(line[i] - paeth(a, b, c))};
+        for (int m = 0; m < 5; m++)
+        {
+            candidates[m * static_cast<std::size_t>(lineLength) + i] = out[m];
+            sads[m] += sad_byte(out[m]);
+        }
+    }
+}
+
+static void candidates_scalar(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *prev, int bpp, uint64_t *sads)
+{
+    candidates_range(line, candidates, lineLength, prev, bpp, sads, 0, lineLength);
+}
+
+#ifdef FILTERS_X86
+
+/**
+ * @brief reading and writing bpp bytes as an integer, with power of two sized accesses(3 and 6 bytes memcpy go through the stack)
+ *
+ */
+template <int bpp>
+static inline uint64_t read_bytes(const uint8_t *pixel)
+{
+    uint16_t low16(0);
+    uint32_t low32(0);
+    uint64_t value(0);
+    if constexpr (bpp == 3 || bpp == 6)
+    {
+        memcpy(&low16, pixel + bpp - 2, 2);
+        if constexpr (bpp == 3)
+            return pixel[0] | static_cast<uint64_t>(low16) << 8;
+
+        memcpy(&low32, pixel, 4);
+        return low32 | static_cast<uint64_t>(low16) << 32;
+    }
+    memcpy(&value, pixel, bpp);
+    return value;
+}
+
+template <int bpp>
+static inline void write_bytes(uint8_t *pixel, uint64_t value)
+{
+    if constexpr (bpp == 3 || bpp == 6)
+    {
+        const uint16_t high16 = static_cast<uint16_t>(value >> (8 * (bpp - 2)));
+        if constexpr (bpp == 3)
+            pixel[0] = static_cast<uint8_t>(value);
+        else
+        {
+            const uint32_t low32 = static_cast<uint32_t>(value);
+            memcpy(pixel, &low32, 4);
+        }
+        memcpy(pixel + bpp - 2, &high16, 2);
+        return;
+    }
+    memcpy(pixel, &value, bpp);
+}
+
+/**
+ * @brief loading and storing a single pixel(bpp bytes) in the low bytes of a register, never reading or writing past it
+ * @note the pixel goes through a general purpose register, a round trip through the stack would stall the store forwarding.
+ */
+template <int bpp>
+FILTERS_SSE2 static inline __m128i load_pixel(const uint8_t *pixel)
+{
+#ifdef __x86_64__
+    return _mm_cvtsi64_si128(static_cast<long long>(read_bytes<bpp>(pixel)));
+#else
+    const uint64_t value = read_bytes<bpp>(pixel);
+    return _mm_loadl_epi64((const __m128i *)&value);
+#endif
+}
+
+template <int bpp>
+FILTERS_SSE2 static inline void store_pixel(uint8_t *pixel, __m128i pixelValue)
+{
+#ifdef __x86_64__
+    write_bytes<bpp>(pixel, static_cast<uint64_t>(_mm_cvtsi128_si64(pixelValue)));
+#else
+    uint64_t value;
+    _mm_storel_epi64((__m128i *)&value, pixelValue);
+    write_bytes<bpp>(pixel, value);
+#endif
+}
+
+/**
+ * @brief Sub, as a prefix sum of the pixels inside a register(log2 shifts), plus the last pixel of the previous register
+ * @note a register holds 16 / bpp whole pixels, the remaining lanes(bpp 3 and 6) are left unchanged and processed by the next register.
+ */
+template <int bpp>
+FILTERS_SSE2 static void sub_sse2(uint8_t *line, int lineLength, const uint8_t *)
+{
+    constexpr int chunk = 16 / bpp * bpp;
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i keep = _mm_slli_si128(ones, chunk);          // lanes after the last whole pixel
+    const __m128i pixelMask = _mm_srli_si128(ones, 16 - bpp); // first pixel lanes
+    __m128i carry = _mm_setzero_si128();                      // the previous pixel, in the first pixel lanes
+
+    // the next register is loaded before the actual one is stored : they overlap with 3 and 6 bytes pixels
+    int i(0);
+    __m128i in = (lineLength >= 16) ? _mm_loadu_si128((const __m128i *)line) : _mm_setzero_si128();
+    for (; i + 16 <= lineLength; i += chunk)
+    {
+        const __m128i next = (i + chunk + 16 <= lineLength) ? _mm_loadu_si128((const __m128i *)(line + i + chunk)) : in;
+
+        __m128i x = _mm_add_epi8(in, carry);
+        x = _mm_add_epi8(x, _mm_slli_si128(x, bpp));
+        if constexpr (2 * bpp < chunk)
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 2 * bpp));
+        if constexpr (4 * bpp < chunk)
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 4 * bpp));
+        if constexpr (8 * bpp < chunk)
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 8 * bpp));
+
+        x = _mm_or_si128(_mm_andnot_si128(keep, x), _mm_and_si128(keep, in));
+        _mm_storeu_si128((__m128i *)(line + i), x);
+        carry = _mm_and_si128(_mm_srli_si128(x, chunk - bpp), pixelMask);
+        in = next;
+    }
+
+    for (i = std::max(i, bpp); i < lineLength; i++) // line end
+        line[i] = (uint8_t)(line[i] + line[i - bpp]);
+}
+
+/**
+ * @brief Up, 16 bytes at once
+ *
+ */
+FILTERS_SSE2 static void up_sse2(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    int i(0);
+    for (; i + 16 <= lineLength; i += 16)
+        _mm_storeu_si128((__m128i *)(line + i), _mm_add_epi8(_mm_loadu_si128((const __m128i *)(line + i)), _mm_loadu_si128((const __m128i *)(prev + i))));
+
+    for (; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + prev[i]);
+}
+
+/**
+ * @brief Up, 32 bytes at once
+ *
+ */
+FILTERS_AVX2 static void up_avx2(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    int i(0);
+    for (; i + 32 <= lineLength; i += 32)
+        _mm256_storeu_si256((__m256i *)(line + i), _mm256_add_epi8(_mm256_loadu_si256((const __m256i *)(line + i)), _mm256_loadu_si256((const __m256i *)(prev + i))));
+
+    for (; i < lineLength; i++)
+        line[i] = (uint8_t)(line[i] + prev[i]);
+}
+
+/**
+ * @brief Average, a pixel at once : floor((a + b) / 2) is the rounded up average(pavgb) minus the lost bit
+ *
+ */
+template <int bpp>
+FILTERS_SSE2 static void average_sse2(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    const __m128i lsb = _mm_set1_epi8(1);
+    __m128i a = _mm_setzero_si128();
+    for (int i = 0; i < lineLength; i += bpp)
+    {
+        const __m128i b = load_pixel<bpp>(prev + i);
+        const __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), lsb));
+        a = _mm_add_epi8(load_pixel<bpp>(line + i), average);
+        store_pixel<bpp>(line + i, a);
+    }
+}
+
+/**
+ * @brief bytes selection, mask ? if_true : if_false
+ *
+ */
+FILTERS_SSE2 static inline __m128i select(__m128i mask, __m128i if_true, __m128i if_false)
+{
+    return _mm_or_si128(_mm_and_si128(mask, if_true), _mm_andnot_si128(mask, if_false));
+}
+
+/**
+ * @brief Paeth, a pixel at once in 16 bits lanes(p - a, p - b and p - c don't fit in bytes)
+ * @note the loop is shared by the SSE2 and SSSE3 kernels, which only differ by the absolute value(pabsw with SSSE3),
+ * each kernel being compiled for its own instruction set.
+ */
+#define PAETH_LOOP(abs16)                                                                                 \
+    const __m128i zero = _mm_setzero_si128();                                                             \
+    __m128i a = zero, c = zero; /* the left and upper left pixels, zeros for the first pixel */          \
+    for (int i = 0; i < lineLength; i += bpp)                                                             \
+    {                                                                                                     \
+        const __m128i b = _mm_unpacklo_epi8(load_pixel<bpp>(prev + i), zero);                             \
+        const __m128i pa = abs16(_mm_sub_epi16(b, c)), pb = abs16(_mm_sub_epi16(a, c));                   \
+        const __m128i pc = abs16(_mm_add_epi16(_mm_sub_epi16(b, c), _mm_sub_epi16(a, c)));                \
+                                                                                                          \
+        /* a if pa <= pb and pa <= pc, else b if pb <= pc, else c */                                      \
+        __m128i predictor = select(_mm_cmpgt_epi16(pb, pc), c, b);                                        \
+        predictor = select(_mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc)), predictor, a); \
+                                                                                                          \
+        const __m128i out = _mm_add_epi8(load_pixel<bpp>(line + i), _mm_packus_epi16(predictor, predictor)); \
+        store_pixel<bpp>(line + i, out);                                                                  \
+                                                                                                          \
+        a = _mm_unpacklo_epi8(out, zero);                                                                 \
+        c = b;                                                                                            \
+    }
+
+FILTERS_SSE2 static inline __m128i abs16_sse2(__m128i x)
+{
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+template <int bpp>
+FILTERS_SSE2 static void paeth_sse2(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    PAETH_LOOP(abs16_sse2)
+}
+
+template <int bpp>
+FILTERS_SSSE3 static void paeth_ssse3(uint8_t *line, int lineLength, const uint8_t *prev)
+{
+    PAETH_LOOP(_mm_abs_epi16)
+}
+
+/**
+ * @brief the five filtered candidates of a line in a single pass : the filters only read the original lines, so each register
+ * of the line is filtered independently, with the left pixels loaded bpp bytes before it.
+ * @details Average's floor((a + b) / 2) is the rounded up average(pavgb) minus the lost bit, Paeth is computed in 16 bits lanes,
+ * each candidate absolute values(as signed bytes, min(v, -v) unsigned) are summed with psadbw while stored.
+ * the first pixel and the line end are computed by the scalar code.
+ */
+#define CANDIDATES_LOOP(VEC, WIDTH, load, store, PREFIX, abs16, select16)                                                  \
+    const std::size_t length = static_cast<std::size_t>(lineLength);                                                   \
+    const VEC zero = PREFIX##_setzero_si##WIDTH(), lsb = PREFIX##_set1_epi8(1);                                          \
+    VEC sums[5] = {zero, zero, zero, zero, zero};                                                                        \
+    const int bytes = WIDTH / 8;                                                                                         \
+    const int first = std::min(bpp, lineLength);                                                                        \
+    int i(first);                                                                                                        \
+    for (; i + bytes <= lineLength; i += bytes)                                                                          \
+    {                                                                                                                    \
+        const VEC x = load((const VEC *)(line + i)), a = load((const VEC *)(line + i - bpp));                           \
+        const VEC b = load((const VEC *)(prev + i)), c = load((const VEC *)(prev + i - bpp));                           \
+                                                                                                                         \
+        /* a if pa <= pb and pa <= pc, else b if pb <= pc, else c */                                                     \
+        VEC predictor[2];                                                                                                \
+        for (int half = 0; half < 2; half++)                                                                             \
+        {                                                                                                                \
+            const VEC a16 = half ? PREFIX##_unpackhi_epi8(a, zero) : PREFIX##_unpacklo_epi8(a, zero);                   \
+            const VEC b16 = half ? PREFIX##_unpackhi_epi8(b, zero) : PREFIX##_unpacklo_epi8(b, zero);                   \
+            const VEC c16 = half ? PREFIX##_unpackhi_epi8(c, zero) : PREFIX##_unpacklo_epi8(c, zero);                   \
+            const VEC pa = abs16(PREFIX##_sub_epi16(b16, c16)), pb = abs16(PREFIX##_sub_epi16(a16, c16));               \
+            const VEC pc = abs16(PREFIX##_add_epi16(PREFIX##_sub_epi16(b16, c16), PREFIX##_sub_epi16(a16, c16)));       \
+            predictor[half] = select16(PREFIX##_cmpgt_epi16(pb, pc), c16, b16);                                          \
+            predictor[half] = select16(PREFIX##_or_si##WIDTH(PREFIX##_cmpgt_epi16(pa, pb), PREFIX##_cmpgt_epi16(pa, pc)), \
+                                       predictor[half], a16);                                                            \
+        }                                                                                                                \
+                                                                                                                         \
+        const VEC average = PREFIX##_sub_epi8(PREFIX##_avg_epu8(a, b), PREFIX##_and_si##WIDTH(PREFIX##_xor_si##WIDTH(a, b), lsb)); \
+        const VEC out[5] = {x, PREFIX##_sub_epi8(x, a), PREFIX##_sub_epi8(x, b), PREFIX##_sub_epi8(x, average),         \
+                            PREFIX##_sub_epi8(x, PREFIX##_packus_epi16(predictor[0], predictor[1]))};                    \
+        for (int m = 0; m < 5; m++)                                                                                      \
+        {                                                                                                                \
+            store((VEC *)(candidates + m * length + i), out[m]);                                                         \
+            const VEC absolute = PREFIX##_min_epu8(out[m], PREFIX##_sub_epi8(zero, out[m]));                            \
+            sums[m] = PREFIX##_add_epi64(sums[m], PREFIX##_sad_epu8(absolute, zero));                                    \
+        }                                                                                                                \
+    }                                                                                                                    \
+                                                                                                                         \
+    for (int m = 0; m < 5; m++)                                                                                          \
+    {                                                                                                                    \
+        uint64_t lanes[bytes / 8];                                                                                       \
+        store((VEC *)lanes, sums[m]);                                                                                    \
+        for (int j = 0; j < bytes / 8; j++)                                                                              \
+            sads[m] += lanes[j];                                                                                         \
+    }                                                                                                                    \
+    candidates_range(line, candidates, lineLength, prev, bpp, sads, 0, first);                                          \
+    candidates_range(line, candidates, lineLength, prev, bpp, sads, i, lineLength);
+
+FILTERS_SSE2 static void candidates_sse2(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *prev, int bpp, uint64_t *sads)
+{
+    CANDIDATES_LOOP(__m128i, 128, _mm_loadu_si128, _mm_storeu_si128, _mm, abs16_sse2, select)
+}
+
+/**
+ * @brief AVX2 versions of the 16 bits lanes helpers
+ *
+ */
+FILTERS_AVX2 static inline __m256i select_avx2(__m256i mask, __m256i if_true, __m256i if_false)
+{
+    return _mm256_blendv_epi8(if_false, if_true, mask);
+}
+
+FILTERS_AVX2 static void candidates_avx2(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *prev, int bpp, uint64_t *sads)
+{
+    // unpacklo, unpackhi and packus work inside each 128 bits lane : the bytes order is kept
+    CANDIDATES_LOOP(__m256i, 256, _mm256_loadu_si256, _mm256_storeu_si256, _mm256, _mm256_abs_epi16, select_avx2)
+}
+
+#endif // FILTERS_X86
+
+/**
+ * @brief the scalar kernels of a pixel size
+ *
+ */
+template <int bpp>
+static KERNELS scalar_kernels()
+{
+    KERNELS kernels;
+    kernels.sub = sub_scalar<bpp>;
+    kernels.up = up_scalar;
+    kernels.average = average_scalar<bpp>;
+    kernels.paeth = paeth_scalar<bpp>;
+    return kernels;
+}
+
+/**
+ * @brief the SIMD kernels replacing the scalar ones, according to the cpu features
+ * @note Average and Paeth are computed a pixel at once(each pixel depends on the previous one), this only pays with 3 bytes pixels or more.
+ */
+template <int bpp>
+static void simd_kernels(KERNELS &kernels, int level)
+{
+#ifdef FILTERS_X86
+    if (level >= 1)
+    {
+        kernels.sub = sub_sse2<bpp>;
+        kernels.up = up_sse2;
+        if (bpp >= 3)
+        {
+            kernels.average = average_sse2<bpp>;
+            kernels.paeth = paeth_sse2<bpp>;
+        }
+    }
+    if (level >= 2 && bpp >= 3)
+        kernels.paeth = paeth_ssse3<bpp>;
+    if (level >= 3)
+        kernels.up = up_avx2;
+#else
+    (void)kernels; (void)level;
+#endif
+}
+
+/**
+ * @brief get the SIMD level supported by the cpu : 0 none, 1 SSE2, 2 SSSE3, 3 AVX2
+ *
+ */
+static int simd_level()
+{
+#ifdef FILTERS_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 3 : __builtin_cpu_supports("ssse3") ? 2 : __builtin_cpu_supports("sse2") ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief get the kernels, indexed by pixel size(1, 2, 3, 4, 6 or 8 bytes), selected once at the first call
+ *
+ */
+static const std::array<KERNELS, 9> &get_kernels()
+{
+    static const std::array<KERNELS, 9> kernels = []()
+    {
+        std::array<KERNELS, 9> k;
+        k[1] = scalar_kernels<1>();  k[2] = scalar_kernels<2>();  k[3] = scalar_kernels<3>();
+        k[4] = scalar_kernels<4>();  k[6] = scalar_kernels<6>();  k[8] = scalar_kernels<8>();
+
+        const int level = simd_level();
+        simd_kernels<1>(k[1], level);  simd_kernels<2>(k[2], level);  simd_kernels<3>(k[3], level);
+        simd_kernels<4>(k[4], level);  simd_kernels<6>(k[6], level);  simd_kernels<8>(k[8], level);
+        return k;
+    }();
+    return kernels;
+}
+
+/**
+ * @brief get the filtering candidates kernel, selected once at the first call
+ *
+ */
+static CANDIDATES_KERNEL get_candidates_kernel()
+{
+    static const CANDIDATES_KERNEL kernel = []()
+    {
+        CANDIDATES_KERNEL k = candidates_scalar;
+#ifdef FILTERS_X86
+        const int level = simd_level();
+        if (level >= 1)
+            k = candidates_sse2;
+        if (level >= 3)
+            k = candidates_avx2;
+#endif
+        return k;
+    }();
+    return kernel;
+}
+
+/**
+ * @brief get the SIMD instruction set used by the filtering and unfiltering kernels
+ *
+ * @return const char*, "AVX2", "SSSE3", "SSE2" or "none"
+ */
+const char *Filters::get_simd_level()
+{
+    static const char *names[] = {"none", "SSE2", "SSSE3", "AVX2"};
+    return names[simd_level()];
+}
+
+/**
+ * @brief in place unfiltering line method
+ * @details the kernels are specialized for each pixel size(1, 2, 3, 4, 6 and 8 bytes) and use the best SIMD instruction set of the cpu,
+ * with the exact same results as the generic unfiltering.
+ * @note the predecessor of the first line is a line of zeros, it can be given as nullptr.
+ *
+ * @param line the line to unfilter, replaced by the unfiltered line
+ * @param lineLength the line length
+ * @param filterMode the filter mode of the actual line ( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)
+ * @param unfiltered_prev_line the predecessor line (already unfiltered), or nullptr for the first line
+ * @param colorChannel the number of bytes per pixel
+ *
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+void Filters::unfilter_line(uint8_t *line, int lineLength, uint8_t filterMode, const uint8_t *unfiltered_prev_line, uint8_t colorChannel)
+{
+    int i(0);
+    if (unfiltered_prev_line == nullptr) // with a line of zeros, Up is None and Paeth is Sub
+    {
+        if (filterMode == 0x2 || filterMode == 0x4)
+            filterMode = (filterMode == 0x2) ? 0x0 : 0x1;
+        else if (filterMode == 0x3)
+        {
+            for (i = colorChannel; i < lineLength; i++)
+                line[i] = (uint8_t)(line[i] + (line[i - colorChannel] >> 1));
+            return;
+        }
+    }
+
+    const KERNELS &kernels = get_kernels()[colorChannel < 9 ? colorChannel : 0];
+    if (kernels.sub != nullptr && lineLength % colorChannel == 0)
+    {
+        switch (filterMode)
+        {
+        case 0x0: return;
+        case 0x1: kernels.sub(line, lineLength, unfiltered_prev_line); return;
+        case 0x2: kernels.up(line, lineLength, unfiltered_prev_line); return;
+        case 0x3: kernels.average(line, lineLength, unfiltered_prev_line); return;
+        case 0x4: kernels.paeth(line, lineLength, unfiltered_prev_line); return;
+        default: break;
+        }
+    }
+
+    // generic unfiltering, any pixel size
+    switch (filterMode)
+    {
+    case 0x0: // filter mode 0(none), nothing to do
+        break;
+
+    case 0x1: // filter mode 1(Sub),
+        for (i = colorChannel; i < lineLength; i++)
+            line[i] = (uint8_t)(line[i] + line[i - colorChannel]);
+        break;
+
+    case 0x2: // filter mode 2(Up)
+        for (i = 0; i < lineLength; i++)
+            line[i] = (uint8_t)(line[i] + unfiltered_prev_line[i]);
+        break;
+
+    case 0x3: // filter mode 3(Average)
+        for (i = 0; i < colorChannel; i++)
+            line[i] = (uint8_t)(line[i] + (unfiltered_prev_line[i] >> 1));
+
+        for (i = colorChannel; i < lineLength; i++)
+            line[i] = (uint8_t)(line[i] + ((line[i - colorChannel] + unfiltered_prev_line[i]) >> 1));
+        break;
+
+    case 0x4: // filter mode 4(Paeth)
+        for (i = 0; i < colorChannel; i++)
+            line[i] = (uint8_t)(line[i] + unfiltered_prev_line[i]);
+
+        for (i = colorChannel; i < lineLength; i++)
+            line[i] = (uint8_t)(line[i] + Utilities::paeth_predictor(line[i - colorChannel], unfiltered_prev_line[i], unfiltered_prev_line[i - colorChannel]));
+        break;
+
+    default:
+        throw std::invalid_argument("Invalid filter mode is specified : 0x" + std::to_string(filterMode));
+        break;
+    }
+}
+
+/**
+ * @brief filtering line method
+ * @details png format has many filtering options for improving the compression(deflate)
+ * then after decompression(inflate), datas needs to be unfiltered, according to the specified filter method
+ * @note the predecessor of the first line is a line of zeros, it can be given as nullptr.
+ *
+ * @param line the line to filter
+ * @param filtered the filtered line output, lineLength bytes(not overlapping the input lines)
+ * @param lineLength the line length
+ * @param filterMode the filter mode of the actual line ( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)
+ * @param unfiltered_prev_line the predecessor line (no filtered), or nullptr for the first line
+ * @param colorChannel the number of bytes per pixel
+ *
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+void Filters::filter_line(const uint8_t *line, uint8_t *filtered, int lineLength, uint8_t filterMode, const uint8_t *unfiltered_prev_line, uint8_t colorChannel)
+{
+    int i(0);
+    const int first = std::min<int>(colorChannel, lineLength);
+    if (unfiltered_prev_line == nullptr) // with a line of zeros, Up is None and Paeth is Sub
+    {
+        if (filterMode == 0x2 || filterMode == 0x4)
+            filterMode = (filterMode == 0x2) ? 0x0 : 0x1;
+        else if (filterMode == 0x3)
+        {
+            memcpy(filtered, line, first);
+            for (i = colorChannel; i < lineLength; i++)
+                filtered[i] = (uint8_t)(line[i] - (line[i - colorChannel] >> 1));
+            return;
+        }
+    }
+
+    switch (filterMode)
+    {
+    case 0x0: // filter mode 0(none), the filtered line is the line
+        memcpy(filtered, line, lineLength);
+        break;
+
+    case 0x1: // filter mode 1(Sub),
+        memcpy(filtered, line, first);
+        for (i = colorChannel; i < lineLength; i++)
+            filtered[i] = (uint8_t)(line[i] - line[i - colorChannel]);
+        break;
+
+    case 0x2: // filter mode 2(Up)
+        for (i = 0; i < lineLength; i++)
+            filtered[i] = (uint8_t)(line[i] - unfiltered_prev_line[i]);
+        break;
+
+    case 0x3: // filter mode 3(Average)
+        for (i = 0; i < first; i++)
+            filtered[i] = (uint8_t)(line[i] - (unfiltered_prev_line[i] >> 1));
+
+        for (i = colorChannel; i < lineLength; i++)
+            filtered[i] = (uint8_t)(line[i] - ((line[i - colorChannel] + unfiltered_prev_line[i]) >> 1));
+        break;
+
+    case 0x4: // filter mode 4(Paeth)
+        for (i = 0; i < first; i++)
+            filtered[i] = (uint8_t)(line[i] - unfiltered_prev_line[i]);
+
+        for (i = colorChannel; i < lineLength; i++)
+            filtered[i] = (uint8_t)(line[i] - paeth(line[i - colorChannel], unfiltered_prev_line[i], unfiltered_prev_line[i - colorChannel]));
+        break;
+
+    default:
+        throw std::invalid_argument("Invalid filter mode is specified : 0x" + std::to_string(filterMode));
+        break;
+    }
+}
+
+/**
+ * @brief method for filtering a line with the five filter modes at once
+ * @details a single pass over the line(and its predecessor) with the best SIMD instruction set of the cpu, any pixel size,
+ * with the exact same results as filter_line(). each candidate sum of absolute values(as signed bytes) is computed meanwhile.
+ * @note the predecessor of the first line is a line of zeros, it can be given as nullptr.
+ *
+ * @param line the line to filter
+ * @param candidates the filtered lines output, 5 * lineLength bytes : the line filtered with the mode m at candidates + m * lineLength
+ * @param lineLength the line length
+ * @param unfiltered_prev_line the predecessor line (no filtered), or nullptr for the first line
+ * @param colorChannel the number of bytes per pixel
+ * @param sads the output sums of absolute values, 5 values indexed by filter mode
+ */
+void Filters::filter_candidates(const uint8_t *line, uint8_t *candidates, int lineLength, const uint8_t *unfiltered_prev_line, uint8_t colorChannel, uint64_t *sads)
+{
+    for (int m = 0; m < 5; m++)
+        sads[m] = 0;
+
+    if (unfiltered_prev_line == nullptr) // only the first line of the image, not worth a zeros line for the SIMD kernels
+        candidates_scalar(line, candidates, lineLength, nullptr, colorChannel, sads);
+    else
+        get_candidates_kernel()(line, candidates, lineLength, unfiltered_prev_line, colorChannel, sads);
+}
@@ -0,0 +1,597 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "../../include/PNG/Formats.h"
+
+// x86 SIMD kernels, compiled for their own instruction set and selected at runtime(the rest of the library stays generic)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define FORMATS_X86
+    #include <immintrin.h>
+
+    #define FORMATS_SSE2 __attribute__((target("sse2")))
+    #define FORMATS_SSSE3 __attribute__((target("ssse3")))
+    #define FORMATS_AVX2 __attribute__((target("avx2")))
+#endif
+
+
+/** byte swapping kernel, for a buffer of 16 bits samples*/
+typedef void (*SWAP_KERNEL)(uint8_t *samples, std::size_t length);
+
+/** pixels conversion kernel, converts the first pixels of a line and returns how many were converted(the rest is left to the scalar kernel)*/
+typedef std::size_t (*CONVERT_KERNEL)(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, bool depth16, int outChannels, bool bgr);
+
+/** lut expansion kernel, expands the first indexes of a line and returns how many were expanded(the rest is left to the scalar kernel)*/
+typedef std::size_t (*EXPAND_KERNEL)(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut);
+
+/**
+ * @brief scalar byte swapping, 4 samples at once in a 64 bits register
+ *
+ */
+static void swap_16_scalar(uint8_t *samples, std::size_t length)
+{
+    std::size_t i(0);
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t value;
+        memcpy(&value, samples + i, 8);
+        value = ((value & 0x00FF00FF00FF00FFull) << 8) | ((value >> 8) & 0x00FF00FF00FF00FFull);
+        memcpy(samples + i, &value, 8);
+    }
+
+    for (; i + 2 <= length; i += 2)
+    {
+        const uint8_t high = samples[i];
+        samples[i] = samples[i + 1];
+        samples[i + 1] = high;
+    }
+}
+
+/**
+ * @brief 16 bits to 8 bits sample reduction, rounded to the nearest : (value * 255 + 32895) >> 16
+ *
+ */
+static inline uint8_t reduce_16(uint32_t value)
+{
+    return static_cast<uint8_t>((value * 255 + 32895) >> 16);
+}
+
+/**
+ * @brief scalar pixels conversion, from the pixel first to the end of the line
+ * @details gray samples are copied in the three color channels, and a missing alpha channel is opaque(255).
+ *
+ */
+static void convert_scalar(const uint8_t *line, uint8_t *output, std::size_t first, std::size_t pixels, int samples, bool depth16, int outChannels, bool bgr)
+{
+    const bool gray = samples <= 2, alpha = samples == 2 || samples == 4;
+    for (std::size_t p = first; p < pixels; ++p)
+    {
+        const uint8_t *pixel = line + p * samples * (depth16 ? 2 : 1);
+        auto sample = [pixel, depth16](int k) -> uint8_t
+        {
+            return depth16 ? reduce_16(static_cast<uint32_t>(pixel[2 * k]) << 8 | pixel[2 * k + 1]) : pixel[k];
+        };
+
+        const uint8_t r = sample(0), g = gray ? r : sample(1), b = gray ? r : sample(2);
+        uint8_t *out = output + p * outChannels;
+        out[0] = bgr ? b : r;
+        out[1] = g;
+        out[2] = bgr ? r : b;
+        if (outChannels == 4)
+            out[3] = alpha ? sample(samples - 1) : 0xFF;
+    }
+}
+
+/**
+ * @brief scalar lut expansion, from the pixel first to the end of the line
+ *
+ */
+static void expand_scalar(const uint8_t *indexes, uint8_t *output, std::size_t first, std::size_t pixels, const uint8_t *lut)
+{
+    for (std::size_t p = first; p < pixels; ++p)
+        memcpy(output + p * 4, lut + indexes[p] * 4, 4);
+}
+
+#ifdef FORMATS_X86
+
+/**
+ * @brief byte swapping, 8 samples at once(shifts of the 16 bits lanes)
+ *
+ */
+FORMATS_SSE2 static void swap_16_sse2(uint8_t *samples, std::size_t length)
+{
+    std::size_t i(0);
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(samples + i));
+        _mm_storeu_si128((__m128i *)(samples + i), _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8)));
+    }
+    swap_16_scalar(samples + i, length - i);
+}
+
+/**
+ * @brief byte swapping, 8 samples at once(pshufb)
+ *
+ */
+FORMATS_SSSE3 static void swap_16_ssse3(uint8_t *samples, std::size_t length)
+{
+    const __m128i shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    std::size_t i(0);
+    for (; i + 16 <= length; i += 16)
+        _mm_storeu_si128((__m128i *)(samples + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(samples + i)), shuffle));
+
+    swap_16_scalar(samples + i, length - i);
+}
+
+/**
+ * @brief byte swapping, 16 samples at once(vpshufb, the shuffle is done inside each 128 bits half)
+ *
+ */
+FORMATS_AVX2 static void swap_16_avx2(uint8_t *samples, std::size_t length)
+{
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                             1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    std::size_t i(0);
+    for (; i + 32 <= length; i += 32)
+        _mm256_storeu_si256((__m256i *)(samples + i), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(samples + i)), shuffle));
+
+    swap_16_scalar(samples + i, length - i);
+}
+
+/**
+ * @brief 16 bits to 8 bits reduction of 8 big endian samples, the results are in the low bytes of the 16 bits lanes
+ * @note (value * 255 + 32895) >> 16 equals (value - (value + 128) / 256 + 128) / 256, computed without overflowing the 16 bits lanes.
+ */
+FORMATS_SSE2 static inline __m128i reduce_16_sse2(__m128i x)
+{
+    const __m128i value = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8)); // big endian to host order
+    const __m128i high = _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(value, 1), _mm_set1_epi16(64)), 7);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_sub_epi16(value, high), _mm_set1_epi16(128)), 8);
+}
+
+/**
+ * @brief loading 4 pixels as 8 bits samples(4 * samples bytes, at the beginning of the register)
+ *
+ */
+template <bool depth16>
+FORMATS_SSE2 static inline __m128i load_4_pixels(const uint8_t *pixels, int samples)
+{
+    const __m128i first = _mm_loadu_si128((const __m128i *)pixels);
+    if constexpr (!depth16)
+        return first;
+
+    const __m128i low = reduce_16_sse2(first);
+    return _mm_packus_epi16(low, samples > 2 ? reduce_16_sse2(_mm_loadu_si128((const __m128i *)(pixels + 16))) : low);
+}
+
+/**
+ * @brief the shuffle of 4 pixels : each output byte takes its input sample, missing alpha bytes are zeros(0x80 index)
+ * then set to 255 by the alpha mask
+ *
+ */
+static void build_shuffle(int samples, int outChannels, bool bgr, uint8_t shuffle[16], uint8_t alphaMask[16])
+{
+    const bool gray = samples <= 2, alpha = samples == 2 || samples == 4;
+    const int channels[4] = {bgr ? 2 : 0, 1, bgr ? 0 : 2, 3}; // output channel -> input color channel(R, G, B, A)
+
+    memset(shuffle, 0x80, 16);
+    memset(alphaMask, 0x0, 16);
+    for (int p = 0; p < 4; ++p)
+        for (int k = 0; k < outChannels; ++k)
+        {
+            const int out = p * outChannels + k;
+            if (channels[k] == 3)
+            {
+                if (alpha)
+                    shuffle[out] = static_cast<uint8_t>(p * samples + samples - 1);
+                else
+                    alphaMask[out] = 0xFF;
+            }
+            else
+                shuffle[out] = static_cast<uint8_t>(p * samples + (gray ? 0 : channels[k]));
+        }
+}
+
+/**
+ * @brief pixels conversion, 4 pixels at once(pshufb), 16 bits samples being reduced in the register before the shuffle
+ *
+ */
+template <bool depth16>
+FORMATS_SSSE3 static std::size_t convert_ssse3_loop(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int outChannels, bool bgr)
+{
+    uint8_t shuffleBytes[16], alphaBytes[16];
+    build_shuffle(samples, outChannels, bgr, shuffleBytes, alphaBytes);
+    const __m128i shuffle = _mm_loadu_si128((const __m128i *)shuffleBytes), alpha = _mm_loadu_si128((const __m128i *)alphaBytes);
+
+    // the loads and the stores are 16 bytes wide, never past the lines ends
+    const std::size_t pixelSize = samples * (depth16 ? 2 : 1), window = (depth16 && samples > 2) ? 32 : 16;
+    const std::size_t inLength = pixels * pixelSize, outLength = pixels * outChannels;
+
+    std::size_t p(0);
+    for (; p + 4 <= pixels && p * pixelSize + window <= inLength && p * outChannels + 16 <= outLength; p += 4)
+    {
+        const __m128i x = _mm_shuffle_epi8(load_4_pixels<depth16>(line + p * pixelSize, samples), shuffle);
+        _mm_storeu_si128((__m128i *)(output + p * outChannels), _mm_or_si128(x, alpha));
+    }
+    return p;
+}
+
+FORMATS_SSSE3 static std::size_t convert_ssse3(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, bool depth16, int outChannels, bool bgr)
+{
+    return depth16 ? convert_ssse3_loop<true>(line, output, pixels, samples, outChannels, bgr) : convert_ssse3_loop<false>(line, output, pixels, samples, outChannels, bgr);
+}
+
+/**
+ * @brief pixels conversion, 8 pixels at once(vpshufb, 4 pixels in each 128 bits half)
+ * @note with 3 bytes output pixels, the two halves are stored separately(12 bytes apart, the second store overwriting the 4 unused bytes of the first).
+ */
+template <bool depth16>
+FORMATS_AVX2 static std::size_t convert_avx2_loop(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int outChannels, bool bgr)
+{
+    uint8_t shuffleBytes[16], alphaBytes[16];
+    build_shuffle(samples, outChannels, bgr, shuffleBytes, alphaBytes);
+    const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)shuffleBytes));
+    const __m256i alpha = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)alphaBytes));
+
+    const std::size_t pixelSize = samples * (depth16 ? 2 : 1), window = (depth16 && samples > 2) ? 32 : 16;
+    const std::size_t inLength = pixels * pixelSize, outLength = pixels * outChannels;
+
+    std::size_t p(0);
+    for (; p + 8 <= pixels && (p + 4) * pixelSize + window <= inLength && (p + 4) * outChannels + 16 <= outLength; p += 8)
+    {
+        const __m128i low = load_4_pixels<depth16>(line + p * pixelSize, samples);
+        const __m128i high = load_4_pixels<depth16>(line + (p + 4) * pixelSize, samples);
+        const __m256i x = _mm256_or_si256(_mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), shuffle), alpha);
+
+        if (outChannels == 4)
+            _mm256_storeu_si256((__m256i *)(output + p * outChannels), x);
+        else
+        {
+            _mm_storeu_si128((__m128i *)(output + p * outChannels), _mm256_castsi256_si128(x));
+            _mm_storeu_si128((__m128i *)(output + (p + 4) * outChannels), _mm256_extracti128_si256(x, 1));
+        }
+    }
+    return p;
+}
+
+FORMATS_AVX2 static std::size_t convert_avx2(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, bool depth16, int outChannels, bool bgr)
+{
+    return depth16 ? convert_avx2_loop<true>(line, output, pixels, samples, outChannels, bgr) : convert_avx2_loop<false>(line, output, pixels, samples, outChannels, bgr);
+}
+
+/**
+ * @brief lut planes of the 16 first entries, for pshufb lookups : red, green, blue then alpha bytes(16 bytes each)
+ *
+ */
+static void build_planes(const uint8_t *lut, uint8_t planes[64])
+{
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 4; ++k)
+            planes[k * 16 + i] = lut[i * 4 + k];
+}
+
+/**
+ * @brief lut expansion of indexes lower than 16, 16 pixels at once : a pshufb lookup in each plane, then the planes are interleaved
+ *
+ */
+FORMATS_SSSE3 static std::size_t expand_ssse3_16(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut)
+{
+    uint8_t planes[64];
+    build_planes(lut, planes);
+    const __m128i red = _mm_loadu_si128((const __m128i *)planes), green = _mm_loadu_si128((const __m128i *)(planes + 16));
+    const __m128i blue = _mm_loadu_si128((const __m128i *)(planes + 32)), alpha = _mm_loadu_si128((const __m128i *)(planes + 48));
+
+    std::size_t p(0);
+    for (; p + 16 <= pixels; p += 16)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(indexes + p));
+        const __m128i r = _mm_shuffle_epi8(red, x), g = _mm_shuffle_epi8(green, x), b = _mm_shuffle_epi8(blue, x), a = _mm_shuffle_epi8(alpha, x);
+
+        const __m128i rgLow = _mm_unpacklo_epi8(r, g), rgHigh = _mm_unpackhi_epi8(r, g);
+        const __m128i baLow = _mm_unpacklo_epi8(b, a), baHigh = _mm_unpackhi_epi8(b, a);
+        _mm_storeu_si128((__m128i *)(output + p * 4), _mm_unpacklo_epi16(rgLow, baLow));
+        _mm_storeu_si128((__m128i *)(output + p * 4 + 16), _mm_unpackhi_epi16(rgLow, baLow));
+        _mm_storeu_si128((__m128i *)(output + p * 4 + 32), _mm_unpacklo_epi16(rgHigh, baHigh));
+        _mm_storeu_si128((__m128i *)(output + p * 4 + 48), _mm_unpackhi_epi16(rgHigh, baHigh));
+    }
+    return p;
+}
+
+/**
+ * @brief lut expansion of indexes lower than 16, 32 pixels at once(vpshufb, 16 pixels in each 128 bits half)
+ * @note the interleaving is done inside each half, the halves are reordered by the stores.
+ */
+FORMATS_AVX2 static std::size_t expand_avx2_16(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut)
+{
+    uint8_t planes[64];
+    build_planes(lut, planes);
+    const __m256i red = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)planes));
+    const __m256i green = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(planes + 16)));
+    const __m256i blue = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(planes + 32)));
+    const __m256i alpha = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(planes + 48)));
+
+    std::size_t p(0);
+    for (; p + 32 <= pixels; p += 32)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i *)(indexes + p));
+        const __m256i r = _mm256_shuffle_epi8(red, x), g = _mm256_shuffle_epi8(green, x), b = _mm256_shuffle_epi8(blue, x), a = _mm256_shuffle_epi8(alpha, x);
+
+        const __m256i rgLow = _mm256_unpacklo_epi8(r, g), rgHigh = _mm256_unpackhi_epi8(r, g);
+        const __m256i baLow = _mm256_unpacklo_epi8(b, a), baHigh = _mm256_unpackhi_epi8(b, a);
+        const __m256i q0 = _mm256_unpacklo_epi16(rgLow, baLow), q1 = _mm256_unpackhi_epi16(rgLow, baLow); // pixels 0-7 and 16-23
+        const __m256i q2 = _mm256_unpacklo_epi16(rgHigh, baHigh), q3 = _mm256_unpackhi_epi16(rgHigh, baHigh); // pixels 8-15 and 24-31
+
+        _mm256_storeu_si256((__m256i *)(output + p * 4), _mm256_permute2x128_si256(q0, q1, 0x20));
+        _mm256_storeu_si256((__m256i *)(output + p * 4 + 32), _mm256_permute2x128_si256(q2, q3, 0x20));
+        _mm256_storeu_si256((__m256i *)(output + p * 4 + 64), _mm256_permute2x128_si256(q0, q1, 0x31));
+        _mm256_storeu_si256((__m256i *)(output + p * 4 + 96), _mm256_permute2x128_si256(q2, q3, 0x31));
+    }
+    return p;
+}
+
+/**
+ * @brief lut expansion of any indexes, 8 pixels at once(vpgatherdd of the 4 bytes entries)
+ *
+ */
+FORMATS_AVX2 static std::size_t expand_avx2_gather(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut)
+{
+    std::size_t p(0);
+    for (; p + 8 <= pixels; p += 8)
+    {
+        const __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(indexes + p)));
+        _mm256_storeu_si256((__m256i *)(output + p * 4), _mm256_i32gather_epi32((const int *)lut, x, 4));
+    }
+    return p;
+}
+
+#endif // FORMATS_X86
+
+/**
+ * @brief get the SIMD level supported by the cpu : 0 none, 1 SSE2, 2 SSSE3, 3 AVX2
+ *
+ */
+static int simd_level()
+{
+#ifdef FORMATS_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 3 : __builtin_cpu_supports("ssse3") ? 2 : __builtin_cpu_supports("sse2") ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief get the byte swapping kernel, selected once at the first call
+ *
+ */
+static SWAP_KERNEL get_swap_kernel()
+{
+    static const SWAP_KERNEL kernel = []() -> SWAP_KERNEL
+    {
+#ifdef FORMATS_X86
+        switch (simd_level())
+        {
+        case 3: return swap_16_avx2;
+        case 2: return swap_16_ssse3;
+        case 1: return swap_16_sse2;
+        default: break;
+        }
+#endif
+        return swap_16_scalar;
+    }();
+    return kernel;
+}
+
+/**
+ * @brief get the pixels conversion kernel, selected once at the first call(nullptr when only the scalar kernel is available)
+ *
+ */
+static CONVERT_KERNEL get_convert_kernel()
+{
+    static const CONVERT_KERNEL kernel = []() -> CONVERT_KERNEL
+    {
+#ifdef FORMATS_X86
+        switch (simd_level())
+        {
+        case 3: return convert_avx2;
+        case 2: return convert_ssse3;
+        default: break;
+        }
+#endif
+        return nullptr;
+    }();
+    return kernel;
+}
+
+/**
+ * @brief get the lut expansion kernel, selected once at the first call(nullptr when only the scalar kernel is available)
+ *
+ * @param small if all the indexes are lower than 16(1, 2 or 4 bits indexes)
+ */
+static EXPAND_KERNEL get_expand_kernel(bool small)
+{
+    static const EXPAND_KERNEL kernels[2] = {[]() -> EXPAND_KERNEL
+    {
+#ifdef FORMATS_X86
+        if (simd_level() == 3)
+            return expand_avx2_gather;
+#endif
+        return nullptr;
+    }(), []() -> EXPAND_KERNEL
+    {
+#ifdef FORMATS_X86
+        switch (simd_level())
+        {
+        case 3: return expand_avx2_16;
+        case 2: return expand_ssse3_16;
+        default: break;
+        }
+#endif
+        return nullptr;
+    }()};
+    return kernels[small ? 1 : 0];
+}
+
+/**
+ * @brief get the SIMD instruction set used by the formats kernels
+ *
+ * @return const char*, "AVX2", "SSSE3", "SSE2" or "none"
+ */
+const char *Formats::get_simd_level()
+{
+    static const char *names[] = {"none", "SSE2", "SSSE3", "AVX2"};
+    return names[simd_level()];
+}
+
+/**
+ * @brief in place byte swapping of 16 bits samples, between big endian(png) and little endian
+ * @note the swapping is its own inverse, it's also used for getting back big endian samples.
+ *
+ * @param samples the samples buffer
+ * @param length the buffer length in bytes, a trailing odd byte is left unchanged
+ */
+void Formats::swap_16(uint8_t *samples, std::size_t length)
+{
+    get_swap_kernel()(samples, length);
+}
+
+/**
+ * @brief method for converting an unfiltered line to 8 bits RGB/BGR(A) pixels
+ * @details gray samples are expanded to the three color channels, the alpha channel is stripped or added(opaque),
+ * 16 bits samples(big endian, as in png files) are rounded to 8 bits.
+ *
+ * @param line the unfiltered line
+ * @param output the output line, at least pixels * outChannels bytes, must not overlap the line
+ * @param pixels the number of pixels to convert
+ * @param samples the number of samples per pixel of the line : 1(gray), 2(gray alpha), 3(RGB) or 4(RGBA)
+ * @param bitDepth the line samples bit depth, 8 or 16
+ * @param outChannels the number of output bytes per pixel, 3(no alpha) or 4(with alpha)
+ * @param bgr if the output color channels are in the B, G, R order
+ *
+ * @exception std::invalid_argument if the samples, the bit depth or the output channels are not managed
+ */
+void Formats::convert_line(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int bitDepth, int outChannels, bool bgr)
+{
+    if (samples < 1 || samples > 4 || (bitDepth != 8 && bitDepth != 16) || (outChannels != 3 && outChannels != 4))
+        throw std::invalid_argument("Formats::convert_line() - Not managed conversion");
+
+    const bool depth16 = bitDepth == 16;
+    const CONVERT_KERNEL kernel = get_convert_kernel();
+    const std::size_t converted = kernel != nullptr ? kernel(line, output, pixels, samples, depth16, outChannels, bgr) : 0;
+
+    convert_scalar(line, output, converted, pixels, samples, depth16, outChannels, bgr);
+}
+
+/**
+ * @brief method for unpacking a line of 1, 2 or 4 bits pixels(the most significant bits first, as in png files) to a byte per pixel
+ *
+ * @param packed the packed line, (pixels * bitDepth + 7) / 8 bytes
+ * @param output the output line, at least pixels bytes, must not overlap the packed line
+ * @param pixels the number of pixels of the line
+ * @param bitDepth the packed pixels bit depth, 1, 2 or 4
+ *
+ * @exception std::invalid_argument if the bit depth is not managed
+ */
+void Formats::unpack_line(const uint8_t *packed, uint8_t *output, std::size_t pixels, int bitDepth)
+{
+    if (bitDepth != 1 && bitDepth != 2 && bitDepth != 4)
+        throw std::invalid_argument("Formats::unpack_line() - Not managed bit depth");
+
+    const int perByte = 8 / bitDepth, mask = (1 << bitDepth) - 1;
+    std::size_t p(0);
+    for (; p + perByte <= pixels; p += perByte) // whole bytes
+    {
+        const uint8_t byte = *packed++;
+        for (int k = 0; k < perByte; ++k)
+            output[p + k] = static_cast<uint8_t>((byte >> (8 - bitDepth * (k + 1))) & mask);
+    }
+
+    for (int k = 0; p < pixels; ++p, ++k) // the last partial byte
+        output[p] = static_cast<uint8_t>((*packed >> (8 - bitDepth * (k + 1))) & mask);
+}
+
+/**
+ * @brief method for packing a line of a byte per pixel to 1, 2 or 4 bits pixels(the most significant bits first, as in png files)
+ * @details only the bitDepth low bits of each pixel are kept, the unused bits of the last byte are zeros.
+ *
+ * @param pixels the line pixels, a byte each
+ * @param packed the packed output line, at least (count * bitDepth + 7) / 8 bytes, must not overlap the pixels
+ * @param count the number of pixels of the line
+ * @param bitDepth the packed pixels bit depth, 1, 2 or 4
+ *
+ * @exception std::invalid_argument if the bit depth is not managed
+ */
+void Formats::pack_line(const uint8_t *pixels, uint8_t *packed, std::size_t count, int bitDepth)
+{
+    if (bitDepth != 1 && bitDepth != 2 && bitDepth != 4)
+        throw std::invalid_argument("Formats::pack_line() - Not managed bit depth");
+
+    const int mask = (1 << bitDepth) - 1;
+    uint8_t byte(0);
+    int bits(0);
+    for (std::size_t p = 0; p < count; ++p)
+    {
+        byte = static_cast<uint8_t>(byte | (pixels[p] & mask) << (8 - bitDepth - bits));
+        bits += bitDepth;
+        if (bits == 8)
+        {
+            *packed++ = byte;
+            byte = 0;
+            bits = 0;
+        }
+    }
+
+    if (bits > 0)
+        *packed = byte;
+}
+
+/**
+ * @brief method for expanding a line of indexes(palette indexes or gray levels, a byte per pixel) to RGBA pixels, through a lookup table
+ * @details the lookup is a SIMD gather : with 1, 2 or 4 bits indexes the 16 first entries are looked up in registers(pshufb),
+ * with 8 bits indexes the entries are gathered from memory(AVX2).
+ *
+ * @param indexes the line indexes, a byte per pixel
+ * @param output the output line, at least pixels * 4 bytes, must not overlap the indexes
+ * @param pixels the number of pixels of the line
+ * @param lut the lookup table, 256 RGBA entries(1024 bytes)
+ * @param bitDepth the indexes bit depth : with 1, 2 or 4 bits, all the indexes must be lower than 16
+ */
+void Formats::expand_line(const uint8_t *indexes, uint8_t *output, std::size_t pixels, const uint8_t *lut, int bitDepth)
+{
+    const EXPAND_KERNEL kernel = get_expand_kernel(bitDepth < 8);
+    const std::size_t expanded = kernel != nullptr ? kernel(indexes, output, pixels, lut) : 0;
+
+    expand_scalar(indexes, output, expanded, pixels, lut);
+}
+
+/**
+ * @brief method for zeroing the alpha of the converted pixels matching the transparent color(tRNS chunk of the gray and RGB images)
+ * @details the samples are compared at full precision, before their rounding to 8 bits : two 16 bits colors rounded
+ * to the same 8 bits color stay distinct.
+ *
+ * @param line the unfiltered line(big endian 16 bits samples, as in png files)
+ * @param output the line converted with 4 output channels(see convert_line()), its alpha channel is updated
+ * @param pixels the number of pixels of the line
+ * @param samples the number of samples per pixel of the line : 1(gray) or 3(RGB)
+ * @param bitDepth the line samples bit depth, 8 or 16
+ * @param key the transparent color samples, as many as the line samples
+ *
+ * @exception std::invalid_argument if the samples or the bit depth are not managed
+ */
+void Formats::mask_transparent(const uint8_t *line, uint8_t *output, std::size_t pixels, int samples, int bitDepth, const uint16_t *key)
+{
+    if ((samples != 1 && samples != 3) || (bitDepth != 8 && bitDepth != 16))
+        throw std::invalid_argument("Formats::mask_transparent() - Not managed samples or bit depth");
+
+    const int bytes = bitDepth / 8;
+    for (std::size_t p = 0; p < pixels; p++, line += samples * bytes)
+    {
+        bool transparent = true;
+        for (int s = 0; s < samples && transparent; s++)
+            transparent = (bytes == 2 ? (line[2 * s] << 8 | line[2 * s + 1]) : line[s]) == key[s];
+
+        if (transparent)
+            output[p * 4 + 3] = 0x0;
+    }
+}
\ No newline at end of file
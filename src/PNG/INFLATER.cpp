@@ -0,0 +1,243 @@
+#include <string>
+#include <climits>
+#include <stdexcept>
+
+#include "../../include/PNG/INFLATER.h"
+
+
+/**
+ * @brief Construct a new INFLATER::INFLATER object
+ *
+ * @param input the png input file
+ * @param chunks the chunks index of the png file
+ *
+ * @exception std::runtime_error if there's no IDAT chunk
+ * @exception std::runtime_error if zlib initialisation failed
+ */
+INFLATER::INFLATER(INPUT_FILE &input, const CHUNK_INDEX &chunks) : m_input(input), m_IDATs(chunks.find_all("IDAT"))
+{
+    if (m_IDATs.empty())
+        throw std::runtime_error("INFLATER::INFLATER() - No IDAT chunk found");
+
+    // initialising zlib
+    m_stream.zalloc = Z_NULL;
+    m_stream.zfree = Z_NULL;
+    m_stream.opaque = Z_NULL;
+    m_stream.avail_in = 0;
+    m_stream.next_in = Z_NULL;
+
+    int result = inflateInit(&m_stream);
+    if (result != Z_OK)
+        throw std::runtime_error("INFLATER::INFLATER() - zlib initialisation failed, error " + std::to_string(result));
+}
+
+/**
+ * @brief Destroy the INFLATER::INFLATER object
+ *
+ */
+INFLATER::~INFLATER()
+{
+    inflateEnd(&m_stream);
+}
+
+/**
+ * @brief method for inflating the next bytes of the scanlines
+ * @details the next IDAT chunk is read(or taken from the file mapping) each time zlib has consumed the previous one.
+ *
+ * @param output the output buffer
+ * @param length the exact number of bytes to inflate into the output buffer
+ *
+ * @exception std::runtime_error if the deflate stream is corrupted
+ * @exception std::runtime_error if the deflate stream ends(or the IDAT chunks are missing) before length bytes are inflated
+ */
+void INFLATER::read(uint8_t *output, std::size_t length)
+{
+    while (length > 0)
+    {
+        if (m_finished)
+            throw std::runtime_error("INFLATER::read() - IDAT datas end before all the scanlines are inflated");
+
+        // next_in switches from chunk to chunk, as zlib consumes them
+        if (m_stream.avail_in == 0)
+        {
+            next_chunk();
+            continue;
+        }
+
+        // avail_out is an uInt, bigger outputs are inflated by parts
+        const uInt part = length > UINT_MAX ? UINT_MAX : static_cast<uInt>(length);
+        m_stream.next_out = (Bytef *)output;
+        m_stream.avail_out = part;
+
+        int result = inflate(&m_stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+            m_finished = true;
+        else if (result != Z_OK && result != Z_BUF_ERROR) // Z_BUF_ERROR only means no progress was possible, more input is needed
+            throw std::runtime_error("INFLATER::read() - Corrupted IDAT datas, zlib error " + std::to_string(result) +
+                                     (m_stream.msg != Z_NULL ? std::string(" : ") + m_stream.msg : std::string()));
+
+        const std::size_t inflated = part - m_stream.avail_out;
+        output += inflated;
+        length -= inflated;
+    }
+}
+
+/**
+ * @brief method for inflating the next bytes of the scanlines, stopping at the end of the actual deflate block
+ * @details used for indexing the deflate stream : at a block boundary(see is_block_boundary()), the inflate state only depends on
+ * the stream position(see get_position() and get_bits()) and on the last 32 KB inflated(the window).
+ *
+ * @param output the output buffer
+ * @param length the maximum number of bytes to inflate into the output buffer(up to UINT_MAX)
+ * @return the number of bytes inflated, less than length if a block boundary or the end of the stream is reached
+ *
+ * @exception std::runtime_error if the deflate stream is corrupted
+ * @exception std::runtime_error if the IDAT chunks are missing before the end of the stream
+ */
+std::size_t INFLATER::read_block(uint8_t *output, std::size_t length)
+{
+    const uInt part = length > UINT_MAX ? UINT_MAX : static_cast<uInt>(length);
+    m_stream.next_out = (Bytef *)output;
+    m_stream.avail_out = part;
+
+    while (m_stream.avail_out > 0 && !m_finished)
+    {
+        if (m_stream.avail_in == 0)
+            next_chunk();
+
+        int result = inflate(&m_stream, Z_BLOCK);
+        if (result == Z_STREAM_END)
+            m_finished = true;
+        else if (result != Z_OK && result != Z_BUF_ERROR)
+            throw std::runtime_error("INFLATER::read_block() - Corrupted IDAT datas, zlib error " + std::to_string(result) +
+                                     (m_stream.msg != Z_NULL ? std::string(" : ") + m_stream.msg : std::string()));
+
+        if (is_block_boundary())
+            break;
+    }
+    return part - m_stream.avail_out;
+}
+
+/**
+ * @brief method for inflating the end of the deflate stream, after the last scanline
+ * @details zlib only checks the adler32 checksum ending the stream when it reaches the end of the stream,
+ * the datas inflated after the scanlines, if any, are ignored.
+ * @note after a seek(), the stream is a raw deflate stream and has no checksum.
+ *
+ * @exception std::runtime_error if the deflate stream is corrupted or its adler32 checksum is invalid
+ * @exception std::runtime_error if the IDAT chunks end before the end of the deflate stream(missing checksum)
+ */
+void INFLATER::finish()
+{
+    uint8_t ignored[256];
+    while (!m_finished)
+    {
+        if (m_stream.avail_in == 0)
+        {
+            next_chunk();
+            continue;
+        }
+
+        m_stream.next_out = (Bytef *)ignored;
+        m_stream.avail_out = sizeof(ignored);
+
+        int result = inflate(&m_stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+            m_finished = true;
+        else if (result != Z_OK && result != Z_BUF_ERROR)
+            throw std::runtime_error("INFLATER::finish() - Corrupted IDAT datas, zlib error " + std::to_string(result) +
+                                     (m_stream.msg != Z_NULL ? std::string(" : ") + m_stream.msg : std::string()));
+    }
+}
+
+/**
+ * @brief method for restarting the inflate at a deflate block boundary, previously given by read_block()
+ * @note the stream is then inflated as a raw deflate stream, its adler32 checksum can't be checked anymore.
+ *
+ * @param position the block boundary position in the deflate stream(the concatenation of the IDAT chunks datas), see get_position()
+ * @param bits the number of bits of the byte before position belonging to the block, see get_bits()
+ * @param window the last bytes inflated before the block boundary(up to 32 KB)
+ * @param windowLength the window length
+ *
+ * @exception std::runtime_error if the position is outside the IDAT datas
+ * @exception std::runtime_error if zlib initialisation failed
+ */
+void INFLATER::seek(uint64_t position, int bits, const uint8_t *window, std::size_t windowLength)
+{
+    inflateEnd(&m_stream);
+    m_stream.avail_in = 0;
+    m_stream.next_in = Z_NULL;
+    int result = inflateInit2(&m_stream, -15); // raw deflate, no zlib header in the middle of the stream
+    if (result != Z_OK)
+        throw std::runtime_error("INFLATER::seek() - zlib initialisation failed, error " + std::to_string(result));
+
+    // the position is in bytes after the partially used byte, if any
+    const uint64_t first = position - (bits > 0 ? 1 : 0);
+    uint64_t start(0);
+    for (m_nextIDAT = 0; m_nextIDAT < m_IDATs.size() && start + m_IDATs[m_nextIDAT]->length <= first; ++m_nextIDAT)
+        start += m_IDATs[m_nextIDAT]->length;
+
+    if (position == 0 || m_nextIDAT == m_IDATs.size())
+        throw std::runtime_error("INFLATER::seek() - Position outside the IDAT datas");
+
+    next_chunk();
+    m_stream.next_in += first - start;
+    m_stream.avail_in -= static_cast<uInt>(first - start);
+
+    if (bits > 0)
+    {
+        inflatePrime(&m_stream, bits, *m_stream.next_in >> (8 - bits));
+        ++m_stream.next_in;
+        --m_stream.avail_in;
+    }
+    if (windowLength > 0)
+        inflateSetDictionary(&m_stream, (const Bytef *)window, static_cast<uInt>(windowLength));
+
+    m_start = position;
+    m_finished = false;
+}
+
+/**
+ * @brief get the actual position in the deflate stream(the concatenation of the IDAT chunks datas)
+ *
+ * @return uint64_t, the number of bytes given to zlib and entirely consumed
+ */
+uint64_t INFLATER::get_position() const noexcept
+{
+    return m_start + m_stream.total_in;
+}
+
+/**
+ * @brief get the number of unused bits of the last byte given to zlib
+ *
+ * @return int, 0 to 7
+ */
+int INFLATER::get_bits() const noexcept
+{
+    return m_stream.data_type & 7;
+}
+
+/**
+ * @brief if the inflate stopped at a deflate block boundary(other than the end of the stream), after read_block()
+ *
+ * @return bool
+ */
+bool INFLATER::is_block_boundary() const noexcept
+{
+    return (m_stream.data_type & 128) && !(m_stream.data_type & 64) && !m_finished;
+}
+
+/**
+ * @brief method for giving the next IDAT chunk datas to zlib
+ *
+ * @exception std::runtime_error if there's no more IDAT chunk
+ */
+void INFLATER::next_chunk()
+{
+    if (m_nextIDAT == m_IDATs.size())
+        throw std::runtime_error("INFLATER::next_chunk() - Truncated IDAT datas");
+
+    const CHUNK_INDEX::ENTRY *IDAT = m_IDATs[m_nextIDAT++];
+    m_stream.next_in = (Bytef *)m_input.read(IDAT->offset, IDAT->length, m_buffer);
+    m_stream.avail_in = IDAT->length;
+}
@@ -0,0 +1,204 @@
+#include <mutex>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include "../../include/PNG/INPUT_FILE.h"
+
+
+/**
+ * @brief Construct a new INPUT_FILE::INPUT_FILE object
+ * @details if try_mapping is set, the file is memory mapped, case the mapping fails(pipes, empty or special files...)
+ * the file is opened as a buffered stream.
+ *
+ * @param path the file path
+ * @param try_mapping if the file should be memory mapped(when possible)
+ *
+ * @exception std::runtime_error if cannot open the file at specified path
+ */
+INPUT_FILE::INPUT_FILE(const std::string &path, bool try_mapping)
+{
+    if (try_mapping && map(path))
+        return;
+
+    m_stream.open(path, std::ios::in | std::ios::binary);
+    if (!m_stream.is_open())
+        throw std::runtime_error("Enable to open the file \"" + path + "\"");
+
+    // pipes and others non seekable streams can't be read at random positions, so we load their whole content
+    std::streamoff len(-1);
+    if (m_stream.seekg(0, std::ios::end))
+        len = m_stream.tellg();
+
+    if (len < 0)
+    {
+        m_stream.clear();
+        m_content.assign(std::istreambuf_iterator<char>(m_stream), std::istreambuf_iterator<char>());
+        m_size = m_content.size();
+        m_in_memory = true;
+        m_stream.close();
+    }
+    else
+    {
+        m_size = static_cast<uint64_t>(len);
+        m_stream.seekg(0, std::ios::beg);
+    }
+}
+
+/**
+ * @brief Destroy the INPUT_FILE::INPUT_FILE object
+ *
+ */
+INPUT_FILE::~INPUT_FILE()
+{
+    unmap();
+}
+
+/**
+ * @brief if the file is memory mapped
+ *
+ * @return either true if the file is memory mapped or false if it's read through a buffered stream
+ */
+bool INPUT_FILE::is_mapped() const noexcept
+{
+    return m_mapping != nullptr;
+}
+
+/**
+ * @brief get the file length
+ *
+ * @return uint64_t
+ */
+uint64_t INPUT_FILE::get_size() const noexcept
+{
+    return m_size;
+}
+
+/**
+ * @brief method for reading a range of the file
+ * @note case the file is memory mapped(or loaded in memory), no copy is done, the returned pointer is inside the mapping
+ * and the buffer is left untouched. otherwise the range is read into the buffer.
+ * @note thread safe, as long as each thread uses its own buffer : the buffered stream readings are serialized.
+ *
+ * @param offset the range position from the file beginning
+ * @param length the range length
+ * @param buffer a buffer to read in, case the file is not mapped
+ * @return a pointer to the range datas, valid until the next read or the file destruction
+ *
+ * @exception std::runtime_error if the range goes beyond the end of the file or cannot be read
+ */
+const uint8_t *INPUT_FILE::read(uint64_t offset, uint32_t length, std::vector<uint8_t> &buffer)
+{
+    if (offset > m_size || length > m_size - offset)
+        throw std::runtime_error("INPUT_FILE::read() - Reading beyond the end of the file");
+
+    if (m_mapping != nullptr)
+        return m_mapping + offset;
+
+    if (m_in_memory)
+        return m_content.data() + offset;
+
+    if (buffer.size() < length)
+        buffer.resize(length);
+
+    // the stream position is shared by all the threads, seeking and reading must not interleave
+    std::lock_guard<std::mutex> lock(m_stream_mutex);
+    m_stream.clear();
+    m_stream.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    if (!m_stream.read(reinterpret_cast<char *>(buffer.data()), length))
+        throw std::runtime_error("INPUT_FILE::read() - Enable to read the file");
+
+    return buffer.data();
+}
+
+/**
+ * @brief method for memory mapping a file(read only)
+ *
+ * @param path the file path
+ * @return either true if the file is mapped or false if it's not a mappable file
+ */
+bool INPUT_FILE::map(const std::string &path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file_handle = file;
+    m_map_handle = mapping;
+    m_mapping = static_cast<const uint8_t *>(view);
+    m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat infos;
+    if (fstat(fd, &infos) == -1 || !S_ISREG(infos.st_mode) || infos.st_size == 0 || // only regular, non-empty files can be mapped
+        static_cast<uint64_t>(infos.st_size) > SIZE_MAX)                             // and must fit in the address space
+    {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<size_t>(infos.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+    if (view == MAP_FAILED)
+        return false;
+
+    madvise(view, static_cast<size_t>(infos.st_size), MADV_SEQUENTIAL); // chunks are walked and inflated in file order
+
+    m_mapping = static_cast<const uint8_t *>(view);
+    m_size = static_cast<uint64_t>(infos.st_size);
+#endif
+    return true;
+}
+
+/**
+ * @brief method for releasing the file mapping
+ *
+ */
+void INPUT_FILE::unmap() noexcept
+{
+    if (m_mapping == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(m_map_handle);
+    CloseHandle(m_file_handle);
+#else
+    munmap(const_cast<uint8_t *>(m_mapping), static_cast<size_t>(m_size));
+#endif
+    m_mapping = nullptr;
+}
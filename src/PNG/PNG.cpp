@@ -1,7 +1,18 @@
 
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
 #include "../../include/PNG/PNG.h"
 #include "../../include/zlib/zlib.h"
+#include "../../include/PNG/CRC32.h"
+#include "../../include/PNG/Filters.h"
+#include "../../include/PNG/Formats.h"
 #include "../../include/PNG/Utilities.h"
+#include "../../include/PNG/SPSC_RING.h"
+#include "../../include/PNG/ROW_DECODER.h"
 
 
 /**
@@ -12,6 +23,7 @@
  * @param s_height the png height information
  * @param bitDepth the png bit depth information
  * @param colorMode the png color mode information, only managed are 0(grayscale), 2(RGB true color) and 6(RGBA)
+ * @note 1, 2 and 4 bits pixels are given a byte per pixel(see PACKING::BYTE).
  */
 PNG::PNG(const uint8_t *pixelBuffer, int s_width, int s_height, int bitDepth, int colorMode)
 {
@@ -25,19 +37,14 @@ PNG::PNG(const uint8_t *pixelBuffer, int s_width, int s_height, int bitDepth, in
     m_signature[6] = 0x1A;
     m_signature[7] = 0x0A;
 
-    uint8_t colorChannels {0};
-    colorChannels = colorMode == 0x0 ? 1 * (bitDepth / 8):
-                    colorMode == 0x1 ? 2 * (bitDepth / 8):
-                    colorMode == 0x2 ? 3 * (bitDepth / 8):
-                    colorMode == 0x6 ? 4 * (bitDepth / 8): 0;
-
-    // copying pixel buffer
-    m_pixelBuffer = new uint8_t[s_width * s_height * colorChannels];
-    memcpy(m_pixelBuffer, pixelBuffer, s_width * s_height * colorChannels);
-
     // setting up criticals png Chunks, calling constructors
     m_IHDR = new IHDR_CHUNK(s_width, s_height, bitDepth, colorMode);
     m_IEND = new IEND_CHUNK();
+
+    // copying pixel buffer
+    const std::size_t pixelsBufferLen = get_pixels_length();
+    m_pixelBuffer = new uint8_t[pixelsBufferLen];
+    memcpy(m_pixelBuffer, pixelBuffer, pixelsBufferLen);
 }
 
 
@@ -56,17 +63,23 @@ PNG::PNG(const PNG &png_src)
     if (png_src.m_pHYs != nullptr) // if source png has a pHYs chunk,
         this->m_pHYs = new PHYS_CHUNK(png_src.m_pHYs->m_ppuX, png_src.m_pHYs->m_ppuY, png_src.m_pHYs->m_unitSpecifier);
 
-    uint8_t colorChannels {0};
-    colorChannels = m_IHDR->m_data[1] == 0x0 ? 1 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x1 ? 2 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x2 ? 3 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x6 ? 4 * (png_src.get_bitDepth() / 8): 0;
-    
+    if (png_src.m_PLTE != nullptr) // palette and transparency of the indexed images
+        this->m_PLTE = new PLTE_CHUNK(png_src.m_PLTE->m_entries.data(), static_cast<uint32_t>(png_src.m_PLTE->m_entries.size()));
+    if (png_src.m_tRNS != nullptr)
+        this->m_tRNS = new TRNS_CHUNK(png_src.m_tRNS->m_datas.data(), static_cast<uint32_t>(png_src.m_tRNS->m_datas.size()));
+
     // copying pixel buffer
-    m_pixelBuffer = new uint8_t[png_src.m_IHDR->m_width * png_src.m_IHDR->m_height * colorChannels];
-    memcpy(m_pixelBuffer, png_src.m_pixelBuffer, png_src.m_IHDR->m_width * png_src.m_IHDR->m_height * colorChannels);
+    this->m_packing = png_src.m_packing;
+    const std::size_t pixelsBufferLen = get_pixels_length();
+    m_pixelBuffer = new uint8_t[pixelsBufferLen];
+    memcpy(m_pixelBuffer, png_src.m_pixelBuffer, pixelsBufferLen);
 
     this->m_IEND = new IEND_CHUNK();
+    this->m_decodeMode = png_src.m_decodeMode;
+    this->m_endianness = png_src.m_endianness;
+    this->m_parallelism = png_src.m_parallelism;
+    this->m_filtering = png_src.m_filtering;
+    this->m_interlacing = png_src.m_interlacing;
 }
 
 
@@ -86,17 +99,23 @@ PNG &PNG::operator=(const PNG &png_src)
     if (png_src.m_pHYs != nullptr) // if source object has a pHYs chunk,
         this->m_pHYs = new PHYS_CHUNK(png_src.m_pHYs->m_ppuX, png_src.m_pHYs->m_ppuY, png_src.m_pHYs->m_unitSpecifier);
 
-    uint8_t colorChannels {0};
-    colorChannels = m_IHDR->m_data[1] == 0x0 ? 1 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x1 ? 2 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x2 ? 3 * (png_src.get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x6 ? 4 * (png_src.get_bitDepth() / 8): 0;
-        
+    if (png_src.m_PLTE != nullptr) // palette and transparency of the indexed images
+        this->m_PLTE = new PLTE_CHUNK(png_src.m_PLTE->m_entries.data(), static_cast<uint32_t>(png_src.m_PLTE->m_entries.size()));
+    if (png_src.m_tRNS != nullptr)
+        this->m_tRNS = new TRNS_CHUNK(png_src.m_tRNS->m_datas.data(), static_cast<uint32_t>(png_src.m_tRNS->m_datas.size()));
+
     // copying pixel buffer
-    m_pixelBuffer = new uint8_t[png_src.m_IHDR->m_width * png_src.m_IHDR->m_height * colorChannels];
-    memcpy(m_pixelBuffer, png_src.m_pixelBuffer, png_src.m_IHDR->m_width * png_src.m_IHDR->m_height * colorChannels);
+    this->m_packing = png_src.m_packing;
+    const std::size_t pixelsBufferLen = get_pixels_length();
+    m_pixelBuffer = new uint8_t[pixelsBufferLen];
+    memcpy(m_pixelBuffer, png_src.m_pixelBuffer, pixelsBufferLen);
 
     this->m_IEND = new IEND_CHUNK();
+    this->m_decodeMode = png_src.m_decodeMode;
+    this->m_endianness = png_src.m_endianness;
+    this->m_parallelism = png_src.m_parallelism;
+    this->m_filtering = png_src.m_filtering;
+    this->m_interlacing = png_src.m_interlacing;
 
     return *this;
 }
@@ -104,20 +123,72 @@ PNG &PNG::operator=(const PNG &png_src)
 
 /**
  * @brief Construct a new PNG::PNG object
+ * @details with DECODE::MAPPED mode, the file is memory mapped and the IDAT chunks datas are inflated directly from the mapping,
+ * case the file can't be mapped(pipes, special files...) it's read through a buffered stream. the mode effectively used is given by get_decode_mode().
+ * 
+ * with ENDIANNESS::NATIVE, 16 bits samples are stored in the host byte order(see get_raw_samples()), each line being swapped
+ * just after its successor is unfiltered(unfiltering needs the big endian previous line), while it's still in cache.
+ * 
+ * with UNFILTER::PARALLEL, the lines are unfiltered by independent runs on several threads, see get_parallelism().
+ * with UNFILTER::PIPELINED, the lines are inflated on a separate thread, ahead of their unfiltering.
+ * 
+ * interlaced(Adam7) images are decoded pass by pass and de-interlaced in the pixels buffer(the png is then saved non interlaced),
+ * on_pass receiving the low resolution image of each pass as soon as its lines are inflated : a placeholder is available
+ * after the first pass, about 1/64 of the datas.
+ * 
+ * indexed images are kept as palette indexes(see get_palette() and get_rgba_pixels() for the expansion on demand),
+ * and 1, 2 and 4 bits pixels are kept a byte per pixel with PACKING::BYTE, or as packed in the png lines with PACKING::PACKED.
  * 
  * @param path the file path of the png file to read
+ * @param decode_mode the file reading mode, DECODE::MAPPED(default) or DECODE::BUFFERED
+ * @param endianness the 16 bits samples byte order, ENDIANNESS::BIG(default, as in png files) or ENDIANNESS::NATIVE
+ * @param unfilter_mode the unfiltering mode, UNFILTER::SEQUENTIAL(default), UNFILTER::PARALLEL or UNFILTER::PIPELINED
+ * @param packing the 1, 2 and 4 bits pixels storage, PACKING::BYTE(default) or PACKING::PACKED
+ * @param on_pass the callback receiving the Adam7 passes low resolution images(interlaced images only), none by default
+ * 
+ * @exception std::runtime_error if cannot open png file as specified path
  */
-PNG::PNG(const std::string &path)
+PNG::PNG(const std::string &path, int decode_mode, int endianness, int unfilter_mode, int packing, const PASS_CALLBACK &on_pass)
 {
-    int s_width(0), s_height(0), pixelsBufferLen(0);
+    INPUT_FILE png_in(path, decode_mode == DECODE::MAPPED);
+    m_decodeMode = png_in.is_mapped() ? DECODE::MAPPED : DECODE::BUFFERED;
+    m_endianness = endianness == ENDIANNESS::NATIVE ? ENDIANNESS::NATIVE : ENDIANNESS::BIG;
+    m_packing = packing == PACKING::PACKED ? PACKING::PACKED : PACKING::BYTE;
+
+    // all the chunks positions, walked once, then used for the criticals and the ancilliary chunks parsing
+    CHUNK_INDEX chunks(png_in);
+
+    int s_width(0), s_height(0);
+    std::size_t pixelsBufferLen(0);
     uint8_t bitDepth(0), colorMode(0), colorChannel(0);
 
     // read pixels from png file(decoding)
-    uint8_t *tmp = PNG::readPixels(path, s_width, s_height, bitDepth, colorMode, colorChannel, pixelsBufferLen);
+    uint8_t *tmp = PNG::readPixels(png_in, chunks, s_width, s_height, bitDepth, colorMode, colorChannel, pixelsBufferLen,
+                                   m_endianness == ENDIANNESS::NATIVE && !Utilities::is_bigEndian(), unfilter_mode, on_pass);
 
-    // copy the parsed pixelBuffer in our own buffer;
-    m_pixelBuffer = new uint8_t[pixelsBufferLen];
-    memcpy(m_pixelBuffer, tmp, pixelsBufferLen);
+    if (bitDepth < 0x8 && m_packing == PACKING::BYTE && s_height > 0) // the decoded lines are packed, unpacking them a pixel per byte
+    {
+        const std::size_t packedLength = pixelsBufferLen / s_height;
+        uint8_t *unpacked = nullptr;
+        try
+        {
+            unpacked = new uint8_t[Utilities::get_buffer_length(s_width, s_height, 1)];
+        }
+        catch (...)
+        {
+            delete[] tmp;
+            throw;
+        }
+
+        for (int i = 0; i < s_height; i++)
+            Formats::unpack_line(tmp + i * packedLength, unpacked + static_cast<std::size_t>(i) * s_width, s_width, bitDepth);
+
+        delete[] tmp;
+        tmp = unpacked;
+    }
+
+    // the parsed pixelBuffer becomes our own buffer, no copy
+    m_pixelBuffer = tmp;
 
     m_signature = new uint8_t[8]; // we assign the PNG signature
     m_signature[0] = 0x89;
@@ -134,35 +205,25 @@ PNG::PNG(const std::string &path)
     m_IEND = new IEND_CHUNK();
 
     // setting up png Ancilliary Chunks
-    std::ifstream png_in(path, std::ios::binary);
-
-    int pos = Utilities::f_strchr(png_in, "pHYs", 0);
-    if(pos != -1) // if PhYs Chunk is present
-    {
-        int ppuX(0), ppuY(0);
-        uint8_t unitSpecifier(0);
-        
-        png_in.seekg(pos, std::ios::beg);
-        png_in.seekg(4, std::ios::cur); // skip word "pHYs"
-
-        uint8_t *ppuXArrayPtr = new uint8_t[4]; // read the physical pixel dimension
-        for (int i = 0; i < 4; i++)
-            png_in >> std::noskipws >> ppuXArrayPtr[i];     // reading
-        ppuX = Utilities::uint8_to_int(ppuXArrayPtr); // storing
-        delete[] ppuXArrayPtr;
-
-        uint8_t *ppuYArrayPtr = new uint8_t[4]; // we read the physical pixel dimension
-        for (int i = 0; i < 4; i++)
-            png_in >> std::noskipws >> ppuYArrayPtr[i];     // reading
-        ppuY = Utilities::uint8_to_int(ppuYArrayPtr); // storing
-        delete[] ppuYArrayPtr;
-
-        png_in >> std::noskipws >> unitSpecifier; // we store the unit specifier
-        m_pHYs = new PHYS_CHUNK(ppuX, ppuY, unitSpecifier);
+    const CHUNK_INDEX::ENTRY *pHYs = chunks.find("pHYs");
+    if (pHYs != nullptr && pHYs->length == 9) // if PhYs Chunk is present
+    {
+        std::vector<uint8_t> buffer;
+        uint8_t physDatas[9]; // ppuX(4 bytes), ppuY(4 bytes), unit specifier(1 byte)
+        memcpy(physDatas, png_in.read(pHYs->offset, 9, buffer), 9);
+        m_pHYs = new PHYS_CHUNK(Utilities::uint8_to_int(physDatas), Utilities::uint8_to_int(physDatas + 4), physDatas[8]);
     }
 
-    
-    delete[] tmp;
+    // the palette was checked by the decoding, the transparency is kept for the color modes using it(with a valid length)
+    std::vector<uint8_t> buffer;
+    const CHUNK_INDEX::ENTRY *PLTE = chunks.find("PLTE");
+    if (colorMode == 0x3)
+        m_PLTE = new PLTE_CHUNK(png_in.read(PLTE->offset, PLTE->length, buffer), PLTE->length);
+
+    const CHUNK_INDEX::ENTRY *tRNS = chunks.find("tRNS");
+    if (tRNS != nullptr && ((colorMode == 0x0 && tRNS->length == 2) || (colorMode == 0x2 && tRNS->length == 6) ||
+                            (colorMode == 0x3 && static_cast<int>(tRNS->length) <= m_PLTE->get_entries_count())))
+        m_tRNS = new TRNS_CHUNK(png_in.read(tRNS->offset, tRNS->length, buffer), tRNS->length);
 }
 
 
@@ -173,24 +234,40 @@ PNG::PNG(const std::string &path)
 PNG::~PNG()
 {
     delete[] m_signature; delete[] m_pixelBuffer;
-    delete m_IHDR;  delete m_pHYs;  delete m_IDAT;  delete m_IEND;
+    delete m_IHDR;  delete m_PLTE;  delete m_pHYs;  delete m_tRNS;  delete m_IDAT;  delete m_IEND;
 }
 
 
 /**
  * @brief writing the actual png in a specific directory path
+ * @details with segment_rows, the deflate stream is cut in independent segments of segment_rows lines, indexed by a private sgIX chunk :
+ * such files are decoded on several threads by this class, and remain valid png files for any other decoder(which ignore the sgIX chunk).
+ * the cost is a slightly bigger file, each segment restarting with an empty deflate history.
+ * 
+ * the filter of each line is selected by strategy : a fixed filter(FILTER_STRATEGY::FIXED) is the fastest, the cost heuristics
+ * (FILTER_STRATEGY::CARDINAL, SAD, ENTROPY) try the five filters, the trial compression(FILTER_STRATEGY::DEFLATE) is the slowest and the most accurate.
+ * FILTER_STRATEGY::ADAPTIVE wraps any of them and mostly reuses the previous line filter, the work done is given by get_filtering().
  * 
  * @param path the path to store the png file
  * @param compress_mode output compression level(according to zlib modes)
+ * @param segment_rows the number of lines of each independently decodable segment, 0(default) for a standard single segment file
+ * @param strategy the scanlines filter selection strategy, FILTER_STRATEGY::CARDINAL(default, the fewest distinct bytes) or any FILTER_STRATEGY
  * @see IHDR_CHUNK::save
+ * @see SGIX_CHUNK::save
  * @see PHYS_CHUNK::save
+ * @see PLTE_CHUNK::save
+ * @see TRNS_CHUNK::save
  * @see IDAT_CHUNK::save
  * @see IEND_CHUNK::save
  * 
  * @exception std::runtime_error if cannot create file as specified path 
+ * @exception std::runtime_error if the png is indexed without palette
  */
-void PNG::save(const std::string &path, int compress_mode)
+void PNG::save(const std::string &path, int compress_mode, int segment_rows, const FILTER_STRATEGY &strategy)
 {
+    if (get_colorMode() == 0x3 && m_PLTE == nullptr)
+        throw std::runtime_error("PNG::save() - Enable to save an indexed png without palette");
+
     std::ofstream output_stream(path.c_str(), std::ios::out | std::ios::binary); // Opening the output file stream
 
     if (output_stream.is_open())
@@ -201,13 +278,50 @@ void PNG::save(const std::string &path, int compress_mode)
         if (m_pHYs != nullptr) // cause pHYs is an auxiliary chunk, we write it only if its present
             m_pHYs->save(output_stream); 
 
-        uint8_t colorChannels {0};
-        colorChannels = m_IHDR->m_data[1] == 0x0 ? 1 * (this->get_bitDepth() / 8):
-                        m_IHDR->m_data[1] == 0x1 ? 2 * (this->get_bitDepth() / 8):
-                        m_IHDR->m_data[1] == 0x2 ? 3 * (this->get_bitDepth() / 8):
-                        m_IHDR->m_data[1] == 0x6 ? 4 * (this->get_bitDepth() / 8): 0;
-        
-        m_IDAT = new IDAT_CHUNK(m_pixelBuffer, m_IHDR->get_width(), m_IHDR->get_height(), colorChannels, compress_mode);
+        if (m_PLTE != nullptr) // the palette and the transparency must precede the IDAT chunks
+            m_PLTE->save(output_stream);
+        if (m_tRNS != nullptr)
+            m_tRNS->save(output_stream);
+
+        // png lines are encoded in bytes : 1, 2 and 4 bits pixels are encoded packed, with a byte per pixel for the filters
+        const int bitDepth = this->get_bitDepth(), width = m_IHDR->get_width(), height = m_IHDR->get_height();
+        const int lineWidth = bitDepth < 0x8 ? static_cast<int>((static_cast<int64_t>(width) * bitDepth + 7) / 8) : width;
+        const uint8_t colorChannels = static_cast<uint8_t>(std::max(1, get_samples(this->get_colorMode()) * bitDepth / 8));
+
+        std::vector<uint8_t> packed;
+        if (bitDepth < 0x8 && m_packing == PACKING::BYTE)
+        {
+            packed.resize(Utilities::get_buffer_length(lineWidth, height, 1));
+            for (int i = 0; i < height; i++)
+                Formats::pack_line(m_pixelBuffer + static_cast<std::size_t>(i) * width, packed.data() + static_cast<std::size_t>(i) * lineWidth, width, bitDepth);
+        }
+        const uint8_t *pixels = packed.empty() ? m_pixelBuffer : packed.data();
+
+        // png samples are big endian, host ordered samples are swapped for the encoding then restored
+        const std::size_t pixelsBufferLen = get_pixels_length();
+        const bool swap16 = m_endianness == ENDIANNESS::NATIVE && this->get_bitDepth() == 0x10 && !Utilities::is_bigEndian();
+        if (swap16)
+            Formats::swap_16(m_pixelBuffer, pixelsBufferLen);
+
+        delete m_IDAT;
+        m_IDAT = nullptr;
+        try
+        {
+            m_IDAT = new IDAT_CHUNK(pixels, lineWidth, height, colorChannels, compress_mode, segment_rows, strategy);
+        }
+        catch (...)
+        {
+            if (swap16)
+                Formats::swap_16(m_pixelBuffer, pixelsBufferLen);
+            throw;
+        }
+        if (swap16)
+            Formats::swap_16(m_pixelBuffer, pixelsBufferLen);
+        m_filtering = {static_cast<uint64_t>(height), m_IDAT->m_trials, m_IDAT->m_candidates};
+
+        if (!m_IDAT->m_segmentOffsets.empty()) // the segments index must be written before the IDAT chunk
+            SGIX_CHUNK(m_IDAT->m_segmentRows, m_IDAT->m_segmentOffsets).save(output_stream);
+
         m_IDAT->save(output_stream);
 
         m_IEND->save(output_stream);
@@ -221,218 +335,663 @@ void PNG::save(const std::string &path, int compress_mode)
 
 /**
  * @brief method for parsing and extracting informations from a specified PNG file
- * @warning only managed are grayscale and rgb images, no indexed colors
+ * @details 1, 2 and 4 bits pixels are decoded packed, as in the png lines, and unfiltered with a byte per pixel.
+ * interlaced images are decoded pass by pass(see decode_adam7()), whatever the unfiltering mode.
  * 
- * @param path the png file path to read/parse
+ * @param input the png input file(mapped or buffered)
+ * @param chunks the chunks index of the png file, giving IHDR and IDAT chunks positions
  * @param s_width  the png width information 
  * @param s_height the png height information
  * @param bitDepth the png bit depth information
- * @param colorMode the png color mode information, only managed are 0(grayscale), 2(RGB true color) and 6(RGBA)
- * @param colorChannel the png color Channels according to the colorMode (colorMode->colorChannel)  0 -> 1, 2 -> 3, 6 -> 4
- * @param pixelsBufferLen the length of the pixels Buffer of the png
+ * @param colorMode the png color mode information : 0(grayscale), 2(RGB true color), 3(indexed), 4(grayscale with alpha) or 6(RGBA)
+ * @param colorChannel the number of bytes per pixel(1 for 1, 2 and 4 bits pixels)
+ * @param pixelsBufferLen the length of the pixels Buffer of the png(packed lines for 1, 2 and 4 bits pixels)
+ * @param swap16 if 16 bits samples must be byte swapped(host byte order output on a little endian host)
+ * @param unfilter_mode the unfiltering mode, UNFILTER::SEQUENTIAL, UNFILTER::PARALLEL or UNFILTER::PIPELINED
+ * @param on_pass the callback receiving the Adam7 passes low resolution images, can be empty
  * @return either nullptr if an error occurred or the pixels buffer, type uint8_t
  * 
- * @exception std::runtime_error if cannot png file as specified path
- * @exception std::runtime_error if bit depth is different than 8 or 16
- * @exception std::runtime_error if color mode is diffrent than 0(grayscale), 1(grayscale with alpha), 2(RGB), 4(RGBA)
- */
-uint8_t *PNG::readPixels(const std::string &path, int &s_width, int &s_height, uint8_t &bitDepth, uint8_t &colorMode, uint8_t &colorChannel, int &pixelsBufferLen)
-{
-    /*for a dynamic parsing purpose(only reading criticals chunk and pHYs), we need to know the exact position of each chunk, characterized
-      here by the chunk type, stored as "word" in a string*/
-
-    std::ifstream input(path, std::ios::in | std::ios::binary); // we start opening the png stream, in binary modes
-    if (input.is_open())                         // if opening is okk
-    {
-        std::string word = "IHDR"; // we start by placing the cursor infront of the header chunk and skip the chunk type ("IHDR")
-        input.seekg(Utilities::f_strchr(input, word, 0) + 4);
-
-        // we read the png width and store it
-        uint8_t *widthArrayPtr = new uint8_t[4];
-        for (int i = 0; i < 4; i++)
-            input >> std::noskipws >> widthArrayPtr[i];
-        s_width = Utilities::uint8_to_int(widthArrayPtr);
-        delete[] widthArrayPtr;
-
-        // same with the png height
-        uint8_t *heightArrayPtr = new uint8_t[4];
-        for (int i = 0; i < 4; i++)
-            input >> std::noskipws >> heightArrayPtr[i];
-        s_height = Utilities::uint8_to_int(heightArrayPtr);
-        delete[] heightArrayPtr;
-
-        // same with the bitDepth annd color mode
-        input >> std::noskipws >> bitDepth;
-        if (bitDepth != 0x8 && bitDepth != 0x10)
-            throw(std::runtime_error("Invalid PNG bit depth, must be 8 or 16"));
-
-        int channel_size = bitDepth / 8; // represents in how many bytes values are stored for each channel.
-        input >> std::noskipws >> colorMode;
-        // according to the parsed color mode value, we set the color channel for the output pixelsBuffer.
-        if (colorMode == 0)
-            pixelsBufferLen = s_height * s_width * (colorChannel = 1*channel_size); // for grayscale images
-        else if (colorMode == 4)
-            pixelsBufferLen = s_height * s_width * (colorChannel = 2*channel_size); // for grayscale alpha images
-        else if (colorMode == 2)
-            pixelsBufferLen = s_height * s_width * (colorChannel = 3*channel_size); // for RGB true color images
-        else if (colorMode == 6)
-            pixelsBufferLen = s_height * s_width * (colorChannel = 4*channel_size); // for RGBA images
-        else
-            throw std::runtime_error("Only Color modes 0(grayscale), 1(grayscale with alpha), 2(RGB true color) and 6(RGBA) are managed");
+ * @exception std::runtime_error if IHDR chunk is missing or invalid, or its crc32 is invalid
+ * @exception std::runtime_error if there's no IDAT chunk or cannot read it
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ * @exception std::runtime_error if color mode is diffrent than 0(grayscale), 2(RGB), 3(indexed), 4(grayscale with alpha), 6(RGBA)
+ * @exception std::runtime_error if bit depth is invalid for the color mode
+ * @exception std::runtime_error if an indexed png has no valid PLTE chunk
+ * @exception std::runtime_error if the interlacing method is different than 0(none) or 1(Adam7)
+ * @exception std::overflow_error if the pixels buffer length doesn't fit in the address space
+ * @note case the file has a valid sgIX chunk(segmented deflate stream), the segments are decoded on separate threads.
+ */
+uint8_t *PNG::readPixels(INPUT_FILE &input, const CHUNK_INDEX &chunks, int &s_width, int &s_height, uint8_t &bitDepth, uint8_t &colorMode, uint8_t &colorChannel, std::size_t &pixelsBufferLen, bool swap16, int unfilter_mode, const PASS_CALLBACK &on_pass)
+{
+    // the header chunk must be the first chunk of the file
+    const CHUNK_INDEX::ENTRY *IHDR = chunks.find("IHDR");
+    if (IHDR == nullptr || IHDR != &chunks.get_entries().front() || IHDR->length != 13)
+        throw std::runtime_error("PNG::readPixels() - Missing or invalid IHDR chunk");
+
+    // the chunks index skips the crcs, but the header sizes the pixels buffer : its crc32 is checked(see probe()) before trusting it.
+    // IHDR being the first chunk, the signature and the whole chunk are the first 33 bytes of the file
+    std::vector<uint8_t> buffer; // reading buffer, only used if the file is not mapped
+    const INFO header = probe(input.read(0, 33, buffer), 33);
+
+    s_width = header.width;
+    s_height = header.height;
+
+    // same with the bitDepth annd color mode
+    bitDepth = header.bitDepth;
+    colorMode = header.colorMode;
+    const int samples = get_samples(colorMode);
+    if (samples == 0)
+        throw std::runtime_error("Only Color modes 0(grayscale), 2(RGB true color), 3(indexed), 4(grayscale with alpha) and 6(RGBA) are managed");
+
+    // 1, 2, 4 or 8 bits for the grayscale and indexed images, 8 or 16 bits otherwise(but indexed)
+    const bool subByte = bitDepth == 0x1 || bitDepth == 0x2 || bitDepth == 0x4;
+    if (!(bitDepth == 0x8 || (bitDepth == 0x10 && colorMode != 0x3) || (subByte && (colorMode == 0x0 || colorMode == 0x3))))
+        throw std::runtime_error("Invalid PNG bit depth, must be 1, 2, 4 or 8 for indexed images, 1, 2, 4, 8 or 16 for grayscale images, 8 or 16 otherwise");
+
+    if (header.interlacing > 0x1)
+        throw std::runtime_error("PNG::readPixels() - Invalid interlacing method, must be 0(none) or 1(Adam7)");
+    m_interlacing = header.interlacing;
+
+    if (colorMode == 0x3)
+    {
+        const CHUNK_INDEX::ENTRY *PLTE = chunks.find("PLTE");
+        if (PLTE == nullptr || PLTE->length == 0 || PLTE->length % 3 != 0 || PLTE->length > 3 * 256)
+            throw std::runtime_error("PNG::readPixels() - Missing or invalid PLTE chunk");
+    }
 
-        // IDAT chunks parsing, can be single or multiples
-        word = "IDAT";
-        input.seekg(0, std::ios::beg);
-        const std::vector<int> &positions(Utilities::f_strchr(input, word)); // getting all the IDAT chunks positions in a vector
+    // the bytes per pixel, for unfiltering : a whole byte for 1, 2 and 4 bits pixels, their lines being packed
+    colorChannel = static_cast<uint8_t>(std::max(1, samples * bitDepth / 8));
+    const int lineWidth = (subByte && s_width > 0) ? static_cast<int>((static_cast<int64_t>(s_width) * bitDepth + 7) / 8) : s_width;
 
-        int deflatedLength(0);
-        int *deflatedLengths = new int[positions.size()]; // array which will containt the IDAT chunks deflated datas lengths
-        for (std::size_t i = 0; i < positions.size(); i++)        // reading and storing each IDAT chunk length
+    pixelsBufferLen = Utilities::get_buffer_length(lineWidth, s_height, colorChannel);
+    swap16 = swap16 && bitDepth == 0x10;
+
+    // interlaced files are decoded pass by pass, a pass being a sequence of dependent lines
+    if (header.interlacing == 0x1)
+    {
+        INFLATER inflater(input, chunks);
+        uint8_t *rawBuffer = new uint8_t[pixelsBufferLen](); // zeros, for the unused bits ending the packed lines
+        try
+        {
+            decode_adam7(inflater, rawBuffer, s_width, s_height, samples * bitDepth, swap16, on_pass);
+        }
+        catch (...)
         {
-            input.seekg(positions[i], std::ios::beg);
-            input.seekg(-4, std::ios::cur);
-
-            // we read and store the actual chunk length
-            uint8_t *deflatedLengthPtr = new uint8_t[4];
-            for (int j = 0; j < 4; j++)
-                input >> std::noskipws >> deflatedLengthPtr[j];                   // reading
-            deflatedLengths[i] = Utilities::uint8_to_int(deflatedLengthPtr);      // storing
-            delete[] deflatedLengthPtr;
-            deflatedLength += deflatedLengths[i];
+            delete[] rawBuffer;
+            throw;
         }
 
-        // then now we have all the lengths of each IDAT chunks, next step is fo read deflated datas
-        int k(0);
-        uint8_t *deflatedBuffer = new uint8_t[deflatedLength]; // mem allocation for the deflated buffer
-        for (int i = 0; i < positions.size(); i++)
+        m_parallelism = {1, s_height, 1};
+        return rawBuffer;
+    }
+
+    // segmented files are inflated and unfiltered segment by segment, on separate threads
+    const CHUNK_INDEX::ENTRY *sgIX = chunks.find("sgIX");
+    if (sgIX != nullptr)
+    {
+        uint8_t *rawBuffer = new uint8_t[pixelsBufferLen];
+        try
+        {
+            std::vector<uint8_t> indexBuffer;
+            const SGIX_CHUNK index(input.read(sgIX->offset, sgIX->length, indexBuffer), sgIX->length);
+            decode_segments(input, chunks, index, rawBuffer, static_cast<std::size_t>(lineWidth) * colorChannel, s_height, colorChannel, swap16);
+
+            const int segments = static_cast<int>(index.m_offsets.size());
+            m_parallelism = {segments, static_cast<int>(std::min<uint32_t>(index.m_rowsPerSegment, s_height)),
+                             static_cast<int>(std::min<unsigned>(segments, std::max(1u, std::thread::hardware_concurrency())))};
+            return rawBuffer;
+        }
+        catch (const std::exception &)
         {
-            input.seekg(positions[i], std::ios::beg); // positioning on each chunk start
-            input.seekg(4, std::ios::cur);            // skipping the chunk type, ("IDAT" word)
+            delete[] rawBuffer; // invalid or outdated index(the IDAT datas were rewritten by another tool), decoding as a single stream
+        }
+    }
+
+    // IDAT chunks parsing, can be single or multiples : they are inflated(decompressed) one after the other, as zlib consumes them
+    INFLATER inflater(input, chunks);
 
-            for (int j = 0; j < deflatedLengths[i]; j++) // copying the deflated data of each chunk in the buffer
+    // each scanline is inflated directly into its raw buffer line(the filter byte apart), then unfiltered in place
+    // using the previous raw line : no scanlines buffer, no line allocation, no copy
+    const std::size_t rowLength = static_cast<std::size_t>(lineWidth) * colorChannel;
+    uint8_t *rawBuffer = new uint8_t[pixelsBufferLen]; // the raw buffer memory allocation
+    try
+    {
+        if (unfilter_mode == UNFILTER::PARALLEL)
+        {
+            // all the lines are inflated first, their filter bytes kept apart, then unfiltered by independent runs
+            std::vector<uint8_t> filters(s_height);
+            for (int i = 0; i < s_height; i++)
             {
-                input >> std::noskipws >> deflatedBuffer[k];
-                k++;
+                inflater.read(&filters[i], 1);
+                inflater.read(rawBuffer + i * rowLength, rowLength);
             }
+            inflater.finish(); // checking the adler32 checksum
+            m_parallelism = unfilter_runs(rawBuffer, filters, rowLength, colorChannel, swap16);
+            return rawBuffer;
         }
 
-        // now we'll inflate(decompress) the deflated pixels and store it into a scanlines buffer
-        uint8_t *scanlines = new uint8_t[pixelsBufferLen + s_height];
-        unsigned long scanlinesLength(pixelsBufferLen + s_height);
-        uncompress(scanlines, &scanlinesLength, deflatedBuffer, deflatedLength); // decompressing...
-
-        // next step is to unfilter each scanline and return the raw buffer
-        uint8_t *unfilteredLine[s_height];
-        uint8_t *rawBuffer = new uint8_t[pixelsBufferLen]; // the raw buffer memory allocation
+        if (unfilter_mode == UNFILTER::PIPELINED && s_height > 1)
+        {
+            decode_pipelined(inflater, rawBuffer, s_height, rowLength, colorChannel, swap16);
+            m_parallelism = {1, s_height, 2};
+            return rawBuffer;
+        }
 
-        for (int i = 1; i <= s_height; i++)
-            memcpy(rawBuffer + (i - 1) * (s_width * colorChannel),                                                                                  // the destination
-                   (unfilteredLine[i - 1] = unfilter_line(scanlines + 1 + (i - 1) * (s_width * colorChannel + 1), s_width * colorChannel, // the source which is the result of the unfiltering each scanline
-                                                          scanlines[(i - 1) * (s_width * colorChannel + 1)], ((i - 1) == 0) ? false : true,
-                                                          ((i - 1) == 0) ? nullptr : rawBuffer + (i - 2) * (s_width * colorChannel), colorChannel)),
-                s_width * colorChannel                                                                                                           // the copying length (which is the unfiltered line length)
-            );
+        m_parallelism = {1, s_height, 1};
+        for (int i = 0; i < s_height; i++)
+        {
+            uint8_t filterMode(0);
+            uint8_t *line = rawBuffer + i * rowLength;
+            inflater.read(&filterMode, 1); // decompressing...
+            inflater.read(line, rowLength);
+            Filters::unfilter_line(line, static_cast<int>(rowLength), filterMode, (i == 0) ? nullptr : line - rowLength, colorChannel);
+
+            if (swap16 && i > 0) // the previous line is not needed anymore
+                Formats::swap_16(line - rowLength, rowLength);
+        }
 
-        input.clear();                                     // clearing the input stream
-        delete[] deflatedBuffer; delete[] scanlines; delete[] deflatedLengths; // freeing allocated memory...
-        for (int i = 0; i < s_height; i++)  delete[] unfilteredLine[i];
+        if (swap16 && s_height > 0)
+            Formats::swap_16(rawBuffer + (s_height - 1) * rowLength, rowLength);
 
-        return rawBuffer; // returning the pixelsBuffer
+        inflater.finish(); // checking the adler32 checksum
     }
-    else
-        throw std::runtime_error("Enable to open the file \"" + path + "\"" );
+    catch (const std::exception &)
+    {
+        delete[] rawBuffer;
+        throw;
+    }
+
+    return rawBuffer; // returning the pixelsBuffer
 }
 
 
 /**
- * @brief unfiltering line method
- * @details png format has many filtering options for improving the compression(deflate)
- * then after decompression(inflate), datas needs to be unfiltered, according to the specified filter method
- * @note filtering and unfiltering methods are applied one each line.
+ * @brief method for decoding an interlaced(Adam7) png, pass by pass
+ * @details each pass is a reduced image of its own(the pixels of the 8 x 8 blocks at the pass positions), with its own filtered lines :
+ * its lines are inflated and unfiltered in two pass lines, then scattered at their positions in the raw buffer.
+ * after each pass the low resolution image of the decoded pixels is given to on_pass(gathered from the raw buffer, the raw buffer itself after the last pass).
  *
- * @param line_in the input line to unfilter
- * @param lineLength the input line length
- * @param filterMode the filter mode of the actual line ( 0 = none, 1 = Sub, 2 = Up, 3 = Average, 4 = Paeth)
- * @param is_prev_line if the actual line have a predecessor line
- * @param unfiltered_prev_line the predecessor line (already unfiltered)
- * @param colorChannel the number of color channel of the input line
- * @return uint8_t* unfiltered line
+ * @param inflater the IDAT datas inflater, positioned on the first line
+ * @param rawBuffer the output raw buffer, s_height de-interlaced lines
+ * @param s_width the png width
+ * @param s_height the png height
+ * @param pixelBits the number of bits per pixel(samples * bit depth)
+ * @param swap16 if 16 bits samples must be byte swapped, while they're scattered
+ * @param on_pass the callback receiving the passes low resolution images, can be empty
  *
- * @exception std::bad_alloc case unfiltered line memory allocation failed
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
  * @exception std::invalid_argument case Invalid filter mode
  */
-uint8_t *PNG::unfilter_line(const uint8_t *line_in, int lineLength, uint8_t filterMode, bool is_prev_line, const uint8_t *unfiltered_prev_line, uint8_t colorChannel)
+void PNG::decode_adam7(INFLATER &inflater, uint8_t *rawBuffer, int s_width, int s_height, int pixelBits, bool swap16, const PASS_CALLBACK &on_pass)
 {
-    int i(0);
-    uint8_t *line_out = new uint8_t[lineLength]; // unfiltered output buffer
-    if (!line_out)
-        throw std::bad_alloc();
+    // passes first column, first line, columns step and lines step, then the low resolution blocks size after each pass
+    static const int xStart[7] = {0, 4, 0, 2, 0, 1, 0}, yStart[7] = {0, 0, 4, 0, 2, 0, 1};
+    static const int xStep[7] = {8, 8, 4, 4, 2, 2, 1}, yStep[7] = {8, 8, 8, 4, 4, 2, 2};
+    static const int blockWidth[7] = {8, 4, 4, 2, 2, 1, 1}, blockHeight[7] = {8, 8, 4, 4, 2, 2, 1};
+
+    const int pixelBytes = pixelBits / 8, colorChannel = std::max(1, pixelBytes), mask = (1 << std::min(pixelBits, 8)) - 1;
+    auto line_length = [pixelBits](int pixels) { return (static_cast<std::size_t>(pixels) * pixelBits + 7) / 8; };
+    const std::size_t rowLength = line_length(s_width);
+
+    // copies the pixel i of a line to the pixel x of another line, 1, 2 and 4 bits pixels being packed
+    auto copy_pixel = [&](const uint8_t *src, std::size_t i, uint8_t *dst, std::size_t x, bool swap)
+    {
+        if (pixelBytes == 0)
+        {
+            const int value = (src[i * pixelBits / 8] >> (8 - pixelBits - (i * pixelBits) % 8)) & mask;
+            const int shift = 8 - pixelBits - static_cast<int>((x * pixelBits) % 8);
+            uint8_t &byte = dst[x * pixelBits / 8];
+            byte = static_cast<uint8_t>((byte & ~(mask << shift)) | value << shift);
+        }
+        else if (swap)
+        {
+            for (int k = 0; k < pixelBytes; k += 2)
+            {
+                dst[x * pixelBytes + k] = src[i * pixelBytes + k + 1];
+                dst[x * pixelBytes + k + 1] = src[i * pixelBytes + k];
+            }
+        }
+        else
+            memcpy(dst + x * pixelBytes, src + i * pixelBytes, pixelBytes);
+    };
 
-    switch (filterMode)
+    std::vector<uint8_t> lines(2 * rowLength), lowResolution;
+    for (int pass = 0; pass < 7; pass++)
     {
-    case 0x0: // filter mode 0(none), output buffer is the same as the in buffer
-        memcpy(line_out, line_in, lineLength);
-        break;
+        const int passWidth = s_width > xStart[pass] ? (s_width - xStart[pass] + xStep[pass] - 1) / xStep[pass] : 0;
+        const int passHeight = s_height > yStart[pass] ? (s_height - yStart[pass] + yStep[pass] - 1) / yStep[pass] : 0;
+        const std::size_t passLength = line_length(passWidth);
+
+        // an empty pass has no line at all(no filter byte)
+        uint8_t *line = lines.data(), *prevLine = nullptr;
+        for (int j = 0; j < passHeight && passWidth > 0; j++)
+        {
+            uint8_t filterMode(0);
+            inflater.read(&filterMode, 1);
+            inflater.read(line, passLength);
+            Filters::unfilter_line(line, static_cast<int>(passLength), filterMode, prevLine, colorChannel);
 
-    case 0x1: // filter mode 1(Sub),
-        memcpy(line_out, line_in, colorChannel);
+            uint8_t *row = rawBuffer + static_cast<std::size_t>(yStart[pass] + j * yStep[pass]) * rowLength;
+            for (int i = 0; i < passWidth; i++)
+                copy_pixel(line, i, row, xStart[pass] + static_cast<std::size_t>(i) * xStep[pass], swap16);
 
-        for (i = colorChannel; i < lineLength; i++)
-            line_out[i] = (uint8_t)(line_in[i] + line_out[i - colorChannel]);
-        break;
+            prevLine = line; // the two pass lines are used alternately
+            line = (line == lines.data()) ? lines.data() + rowLength : lines.data();
+        }
 
-    case 0x2: // filter mode 2(Up)
-        if (!is_prev_line)
-            memcpy(line_out, line_in, lineLength);
+        if (pass == 6) // all the lines are inflated, checking the adler32 checksum before giving the image
+            inflater.finish();
 
-        else
-            for (i = 0; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] + unfiltered_prev_line[i]);
-        break;
+        if (!on_pass)
+            continue;
+
+        PASS low = {pass + 1, (s_width + blockWidth[pass] - 1) / blockWidth[pass], (s_height + blockHeight[pass] - 1) / blockHeight[pass],
+                    blockWidth[pass], blockHeight[pass], rowLength, rawBuffer};
+        if (pass < 6)
+        {
+            low.stride = line_length(low.width);
+            lowResolution.assign(low.stride * low.height, 0x0);
+            for (int y = 0; y < low.height; y++)
+            {
+                const uint8_t *row = rawBuffer + static_cast<std::size_t>(y) * blockHeight[pass] * rowLength;
+                for (int x = 0; x < low.width; x++)
+                    copy_pixel(row, static_cast<std::size_t>(x) * blockWidth[pass], lowResolution.data() + y * low.stride, x, false);
+            }
+            low.pixels = lowResolution.data();
+        }
+        on_pass(low);
+    }
+}
+
+/**
+ * @brief method for decoding a segmented deflate stream(see PNG::save) on several threads
+ * @details each segment starts byte aligned in the deflate stream, with an empty history, and its first line is filtered with None or Sub :
+ * so each thread inflates its segments as raw deflate streams, directly from the IDAT chunks, and unfilters them in place in the raw buffer.
+ * @warning the zlib stream checksum(adler32) covers the whole stream, it can't be checked segment by segment.
+ *
+ * @param input the png input file(mapped or buffered)
+ * @param chunks the chunks index of the png file
+ * @param index the segments index, parsed from the sgIX chunk
+ * @param rawBuffer the output raw buffer, s_height lines of rowLength bytes
+ * @param rowLength the number of bytes of a line
+ * @param s_height the png height
+ * @param colorChannel the number of bytes per pixel
+ * @param swap16 if 16 bits samples must be byte swapped, each line being swapped after its successor is unfiltered
+ *
+ * @exception std::runtime_error if the segments index doesn't match the IDAT datas
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ */
+void PNG::decode_segments(INPUT_FILE &input, const CHUNK_INDEX &chunks, const SGIX_CHUNK &index, uint8_t *rawBuffer, std::size_t rowLength, int s_height, uint8_t colorChannel, bool swap16)
+{
+    const std::vector<const CHUNK_INDEX::ENTRY *> IDATs = chunks.find_all("IDAT");
+    if (IDATs.empty() || chunks.find("sgIX")->offset > IDATs.front()->offset)
+        throw std::runtime_error("PNG::decode_segments() - sgIX chunk must precede the IDAT chunks");
 
-    case 0x3: // filter mode 3(Average)
-        if (!is_prev_line)
+    // each IDAT chunk position in the deflate stream, the stream being the concatenation of the IDAT chunks datas
+    std::vector<uint64_t> starts(1, 0);
+    for (const auto *IDAT : IDATs)
+        starts.push_back(starts.back() + IDAT->length);
+
+    const uint64_t rowsPerSegment = index.m_rowsPerSegment;
+    const std::vector<uint64_t> &offsets = index.m_offsets;
+    if (offsets.size() != (s_height + rowsPerSegment - 1) / rowsPerSegment || offsets.back() + 2 >= starts.back())
+        throw std::runtime_error("PNG::decode_segments() - sgIX chunk doesn't match the IDAT datas");
+
+    auto decode = [&](std::size_t segment, std::vector<uint8_t> &buffer)
+    {
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        stream.avail_in = 0;
+        stream.next_in = Z_NULL;
+        if (inflateInit2(&stream, -15) != Z_OK) // raw deflate, the zlib header is only before the first segment
+            throw std::runtime_error("PNG::decode_segments() - zlib initialisation failed");
+
+        uint64_t position = offsets[segment] + (segment == 0 ? 2 : 0);
+        const uint64_t end = (segment + 1 < offsets.size()) ? offsets[segment + 1] : starts.back();
+        std::size_t chunk = std::upper_bound(starts.begin(), starts.end(), position) - starts.begin() - 1;
+
+        // inflates exactly length bytes of the segment, switching from IDAT chunk to IDAT chunk
+        auto inflate_bytes = [&](uint8_t *output, std::size_t length)
         {
-            memcpy(line_out, line_in, colorChannel);
+            stream.next_out = (Bytef *)output;
+            stream.avail_out = static_cast<uInt>(length); // a line is shorter than INT_MAX bytes(see Utilities::get_buffer_length())
+            while (stream.avail_out > 0)
+            {
+                if (stream.avail_in == 0)
+                {
+                    if (position >= end)
+                        throw std::runtime_error("PNG::decode_segments() - Truncated segment");
+
+                    while (starts[chunk + 1] <= position)
+                        ++chunk;
+
+                    const uint32_t len = static_cast<uint32_t>(std::min(end, starts[chunk + 1]) - position);
+                    stream.next_in = (Bytef *)input.read(IDATs[chunk]->offset + (position - starts[chunk]), len, buffer);
+                    stream.avail_in = len;
+                    position += len;
+                }
+
+                const int result = inflate(&stream, Z_NO_FLUSH);
+                if ((result == Z_STREAM_END && stream.avail_out > 0) || (result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END))
+                    throw std::runtime_error("PNG::decode_segments() - Corrupted segment, zlib error " + std::to_string(result));
+            }
+        };
 
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] + floor((line_out[i - colorChannel]) / 2));
+        try
+        {
+            const int firstRow = static_cast<int>(segment * rowsPerSegment);
+            const int lastRow = static_cast<int>(std::min<uint64_t>(s_height, firstRow + rowsPerSegment));
+            for (int row = firstRow; row < lastRow; ++row)
+            {
+                uint8_t filterMode(0);
+                uint8_t *line = rawBuffer + row * rowLength;
+                inflate_bytes(&filterMode, 1);
+                inflate_bytes(line, rowLength);
+
+                if (row == firstRow && filterMode > 0x1)
+                    throw std::runtime_error("PNG::decode_segments() - Segment first line depends on the previous segment");
+
+                Filters::unfilter_line(line, static_cast<int>(rowLength), filterMode, row == firstRow ? nullptr : line - rowLength, colorChannel);
+
+                if (swap16 && row > firstRow)
+                    Formats::swap_16(line - rowLength, rowLength);
+            }
+
+            if (swap16)
+                Formats::swap_16(rawBuffer + (lastRow - 1) * rowLength, rowLength);
         }
-        else
+        catch (...)
+        {
+            inflateEnd(&stream);
+            throw;
+        }
+        inflateEnd(&stream);
+    };
+
+    // each thread takes the next segment to decode, the first error stops all the threads
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr error(nullptr);
+    std::mutex error_mutex;
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> buffer; // reading buffer, only used if the file is not mapped
+        for (std::size_t i = next++; i < offsets.size(); i = next++)
         {
-            for (i = 0; i < colorChannel; i++)
-                line_out[i] = (uint8_t)(line_in[i] + (floor((unfiltered_prev_line[i]) / 2)));
+            try
+            {
+                decode(i, buffer);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (error == nullptr)
+                    error = std::current_exception();
+                next = offsets.size();
+            }
+        }
+    };
+
+    const std::size_t threads = std::min<std::size_t>(offsets.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> task_s;
+    for (std::size_t i = 1; i < threads; ++i)
+        task_s.emplace_back(worker);
+
+    worker(); // the calling thread decodes too
+    for (auto &task : task_s) // waiting for all threads to finish
+        task.join();
+
+    if (error != nullptr)
+        std::rethrow_exception(error);
+}
+
+
+/**
+ * @brief method for decoding the lines with the inflating and the unfiltering overlapped, on two threads
+ * @details a producer thread inflates each line directly into its raw buffer line then pushes its filter byte in a lock-free ring,
+ * the calling thread pops the filter bytes and unfilters the lines behind it. the ring is sized in lines(about 256 KB of inflated lines) :
+ * the producer can't go further ahead, so the lines are still in cache when unfiltered.
+ * @note both threads spin(yielding) when the ring is full or empty, the slowest stage sets the decoding speed.
+ *
+ * @param inflater the IDAT datas inflater, positioned on the first line
+ * @param rawBuffer the output raw buffer, s_height lines of rowLength bytes
+ * @param s_height the png height
+ * @param rowLength the number of bytes of a line
+ * @param colorChannel the number of bytes per pixel
+ * @param swap16 if 16 bits samples must be byte swapped, each line being swapped after its successor is unfiltered
+ *
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+void PNG::decode_pipelined(INFLATER &inflater, uint8_t *rawBuffer, int s_height, std::size_t rowLength, uint8_t colorChannel, bool swap16)
+{
+    SPSC_RING<uint8_t> filters(std::min<std::size_t>(s_height, std::max<std::size_t>(4, (256 * 1024) / (rowLength + 1))));
+    std::atomic<bool> stop(false);
+    std::exception_ptr error(nullptr);
+
+    std::thread producer([&]()
+    {
+        try
+        {
+            for (int i = 0; i < s_height && !stop; i++)
+            {
+                uint8_t filterMode(0);
+                inflater.read(&filterMode, 1);
+                inflater.read(rawBuffer + i * rowLength, rowLength);
+
+                while (!filters.push(filterMode)) // the ring is full, waiting for the unfiltering
+                {
+                    if (stop)
+                        return;
+                    std::this_thread::yield();
+                }
+            }
 
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] + floor((line_out[i - colorChannel] + unfiltered_prev_line[i]) / 2));
+            if (!stop)
+                inflater.finish(); // checking the adler32 checksum
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+            stop = true;
         }
-        break;
+    });
 
-    case 0x4: // filter mode 4(Paeth)
-        if (!is_prev_line)
+    // the next filter byte, false if the producer failed
+    auto next_filter = [&](uint8_t &filterMode)
+    {
+        while (!filters.pop(filterMode))
         {
-            memcpy(line_out, line_in, colorChannel);
+            if (stop)
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    };
 
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] + Utilities::paeth_predictor(line_out[i - colorChannel], 0, 0));
+    try
+    {
+        uint8_t filterMode(0);
+        for (int i = 0; i < s_height && next_filter(filterMode); i++)
+        {
+            uint8_t *line = rawBuffer + i * rowLength;
+            Filters::unfilter_line(line, static_cast<int>(rowLength), filterMode, (i == 0) ? nullptr : line - rowLength, colorChannel);
+
+            if (swap16 && i > 0)
+                Formats::swap_16(line - rowLength, rowLength);
         }
-        else
+    }
+    catch (...)
+    {
+        stop = true;
+        producer.join();
+        throw;
+    }
+    producer.join();
+
+    if (error != nullptr)
+        std::rethrow_exception(error);
+
+    if (swap16)
+        Formats::swap_16(rawBuffer + (s_height - 1) * rowLength, rowLength);
+}
+
+/**
+ * @brief method for unfiltering inflated lines by independent runs, on several threads
+ * @details a line filtered with None or Sub doesn't depend on the previous line : each such line starts a run, unfiltered
+ * on its own from its first line. the runs are shared between the threads, the longest ones first.
+ *
+ * @param rawBuffer the inflated lines(without their filter bytes), unfiltered in place
+ * @param filters the filter byte of each line
+ * @param rowLength the number of bytes of a line
+ * @param colorChannel the number of bytes per pixel
+ * @param swap16 if 16 bits samples must be byte swapped, each line being swapped after its successor is unfiltered
+ * @return PARALLELISM the runs found and the threads used
+ *
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+PNG::PARALLELISM PNG::unfilter_runs(uint8_t *rawBuffer, const std::vector<uint8_t> &filters, std::size_t rowLength, uint8_t colorChannel, bool swap16)
+{
+    const int s_height = static_cast<int>(filters.size());
+
+    // the first line of a run only needs the line of zeros(None and Sub ignore it), the filters are checked before any thread starts
+    std::vector<int> starts;
+    for (int i = 0; i < s_height; i++)
+    {
+        if (filters[i] > 0x4)
+            throw std::invalid_argument("Invalid filter mode is specified : 0x" + std::to_string(filters[i]));
+        if (i == 0 || filters[i] <= 0x1)
+            starts.push_back(i);
+    }
+    starts.push_back(s_height);
+
+    std::vector<std::size_t> order(starts.size() - 1);
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&starts](std::size_t a, std::size_t b) { return starts[a + 1] - starts[a] > starts[b + 1] - starts[b]; });
+
+    PARALLELISM parallelism = {static_cast<int>(order.size()), order.empty() ? 0 : starts[order[0] + 1] - starts[order[0]], 1};
+    parallelism.threads = static_cast<int>(std::min<std::size_t>(order.size(), std::max(1u, std::thread::hardware_concurrency())));
+
+    // each thread takes the next longest run
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]()
+    {
+        for (std::size_t i = next++; i < order.size(); i = next++)
         {
-            for (i = 0; i < colorChannel; i++)
-                line_out[i] = (uint8_t)(line_in[i] + unfiltered_prev_line[i]); 
+            const int first = starts[order[i]], last = starts[order[i] + 1];
+            for (int row = first; row < last; ++row)
+            {
+                uint8_t *line = rawBuffer + row * rowLength;
+                Filters::unfilter_line(line, static_cast<int>(rowLength), filters[row], row == first ? nullptr : line - rowLength, colorChannel);
+
+                if (swap16 && row > first)
+                    Formats::swap_16(line - rowLength, rowLength);
+            }
 
-            for (i = colorChannel; i < lineLength; i++)
-                line_out[i] = (uint8_t)(line_in[i] + Utilities::paeth_predictor(line_out[i - colorChannel], unfiltered_prev_line[i], unfiltered_prev_line[i - colorChannel]));
+            if (swap16)
+                Formats::swap_16(rawBuffer + (last - 1) * rowLength, rowLength);
         }
-        break;
+    };
+
+    std::vector<std::thread> task_s;
+    for (int i = 1; i < parallelism.threads; ++i)
+        task_s.emplace_back(worker);
+
+    worker(); // the calling thread unfilters too
+    for (auto &task : task_s) // waiting for all threads to finish
+        task.join();
+
+    return parallelism;
+}
+
+/**
+ * @brief get the number of samples per pixel of a png color mode
+ * 
+ * @param colorMode the png color mode
+ * @return int, 1(grayscale or indexed), 2(grayscale with alpha), 3(RGB) or 4(RGBA), 0 if the color mode is invalid
+ */
+int PNG::get_samples(int colorMode) noexcept
+{
+    switch (colorMode)
+    {
+    case 0x0: case 0x3: return 1;
+    case 0x4: return 2;
+    case 0x2: return 3;
+    case 0x6: return 4;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief get the length of the pixels buffer, according to the png header and the pixels packing
+ * 
+ * @return std::size_t
+ * 
+ * @exception std::overflow_error if the pixels buffer length doesn't fit in the address space
+ */
+std::size_t PNG::get_pixels_length() const
+{
+    const int width = m_IHDR->m_width, bitDepth = m_IHDR->m_data[0];
+    if (bitDepth >= 0x8)
+        return Utilities::get_buffer_length(width, m_IHDR->m_height, get_samples(m_IHDR->m_data[1]) * bitDepth / 8);
+
+    // 1, 2 and 4 bits pixels, a sample per pixel
+    const int lineWidth = (m_packing == PACKING::PACKED && width > 0) ? static_cast<int>((static_cast<int64_t>(width) * bitDepth + 7) / 8) : width;
+    return Utilities::get_buffer_length(lineWidth, m_IHDR->m_height, 1);
+}
 
-    default:
-        throw std::invalid_argument("Invalid filter mode is specified : 0x" + std::to_string(filterMode));
-        break;
+/**
+ * @brief get the RGBA lookup table of the palette indexes or of the gray levels(up to 8 bits), for the expansion to RGBA
+ * @details the indexes beyond the palette are opaque black, the transparent gray level(tRNS chunk) has a zero alpha.
+ * 
+ * @return std::vector<uint8_t> 256 RGBA entries(1024 bytes)
+ */
+std::vector<uint8_t> PNG::get_lut() const
+{
+    std::vector<uint8_t> lut(256 * 4, 0x0);
+    for (int i = 0; i < 256; i++)
+        lut[i * 4 + 3] = 0xFF;
+
+    if (get_colorMode() == 0x3)
+    {
+        const std::vector<uint8_t> palette = get_palette();
+        std::copy(palette.begin(), palette.end(), lut.begin());
+        return lut;
     }
-    return line_out;
+
+    const int levels = 1 << get_bitDepth();
+    const int transparent = (m_tRNS != nullptr && m_tRNS->m_datas.size() == 2) ? (m_tRNS->m_datas[0] << 8 | m_tRNS->m_datas[1]) : -1;
+    for (int i = 0; i < levels; i++)
+    {
+        const uint8_t gray = static_cast<uint8_t>(i * 255 / (levels - 1)); // scaling to 8 bits(1, 2 and 4 bits levels divide 255)
+        lut[i * 4] = lut[i * 4 + 1] = lut[i * 4 + 2] = gray;
+        lut[i * 4 + 3] = (i == transparent) ? 0x0 : 0xFF;
+    }
+    return lut;
 }
 
+/**
+ * @brief get the number of bytes per pixel of an output format
+ * 
+ * @param format the output pixels format
+ * @return int, 0 for FORMAT::ORIGINAL(the png layout), 3 or 4 for the 8 bits RGB/BGR(A) formats
+ * 
+ * @exception std::invalid_argument if the format is not managed
+ */
+int PNG::get_format_size(int format)
+{
+    switch (format)
+    {
+    case FORMAT::ORIGINAL: return 0;
+    case FORMAT::RGB8: case FORMAT::BGR8: return 3;
+    case FORMAT::RGBA8: case FORMAT::BGRA8: return 4;
+    default: throw std::invalid_argument("PNG::get_format_size() - Invalid output pixels format");
+    }
+}
+
+
 /**
  * @brief get png width
  * 
@@ -475,16 +1034,354 @@ uint8_t PNG::get_colorMode() const noexcept
 
 /**
  * @brief get png interlacing mode
+ * @note the interlacing method of the decoded file(0 none, 1 Adam7) : the pixels buffer is de-interlaced whatever the method,
+ * and the png is saved non interlaced.
  * 
  * @return uint8_t 
  */
 uint8_t PNG::get_interlacing() const noexcept
 {
-    return this->m_IHDR->get_interlacing();
+    return m_interlacing;
+}
+
+/**
+ * @brief get the input file reading mode used for decoding
+ * @note DECODE::MAPPED was requested but DECODE::BUFFERED is returned when the file couldn't be memory mapped.
+ * 
+ * @return int either DECODE::MAPPED or DECODE::BUFFERED
+ */
+int PNG::get_decode_mode() const noexcept
+{
+    return this->m_decodeMode;
+}
+
+/**
+ * @brief get the byte order of the 16 bits samples inside the pixels buffer
+ * 
+ * @return int either ENDIANNESS::BIG or ENDIANNESS::NATIVE
+ */
+int PNG::get_endianness() const noexcept
+{
+    return this->m_endianness;
+}
+
+/**
+ * @brief get the unfiltering parallelism found by the decoding
+ * @note with UNFILTER::SEQUENTIAL the whole image is a single run, a segmented file(see PNG::save()) is decoded by segments whatever the mode.
+ * 
+ * @return PARALLELISM the number of independent runs, the longest run and the threads used
+ */
+PNG::PARALLELISM PNG::get_parallelism() const noexcept
+{
+    return this->m_parallelism;
+}
+
+/**
+ * @brief get the filter selection work of the last save()
+ * 
+ * @return FILTERING the number of lines, of full trials and of evaluated candidates(all 0 before the first save)
+ */
+PNG::FILTERING PNG::get_filtering() const noexcept
+{
+    return this->m_filtering;
+}
+
+/**
+ * @brief get the storage of the 1, 2 and 4 bits pixels inside the pixels buffer
+ * 
+ * @return int either PACKING::BYTE or PACKING::PACKED
+ */
+int PNG::get_packing() const noexcept
+{
+    return this->m_packing;
+}
+
+/**
+ * @brief get the palette of an indexed png, with the alpha of each entry(tRNS chunk, opaque by default)
+ * 
+ * @return std::vector<uint8_t> the RGBA palette entries(4 bytes each), empty if the png has no palette
+ */
+std::vector<uint8_t> PNG::get_palette() const
+{
+    std::vector<uint8_t> palette;
+    if (m_PLTE == nullptr)
+        return palette;
+
+    const int entries = m_PLTE->get_entries_count();
+    palette.resize(static_cast<std::size_t>(entries) * 4);
+    for (int i = 0; i < entries; i++)
+    {
+        memcpy(palette.data() + i * 4, m_PLTE->m_entries.data() + i * 3, 3);
+        palette[i * 4 + 3] = (m_tRNS != nullptr && i < static_cast<int>(m_tRNS->m_datas.size())) ? m_tRNS->m_datas[i] : 0xFF;
+    }
+    return palette;
+}
+
+/**
+ * @brief method for retrieving png header informations, without decoding the png
+ * @details only the first 33 bytes of the file are read : signature(8 bytes) and IHDR chunk(4 + 4 + 13 + 4 bytes).
+ * 
+ * @param path the png file path
+ * @return PNG::INFO the png header informations
+ * 
+ * @exception std::runtime_error if cannot open png file as specified path
+ * @exception std::runtime_error if the file is too short, the signature, the IHDR chunk or its crc32 is invalid
+ */
+PNG::INFO PNG::probe(const std::string &path)
+{
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (!input.is_open())
+        throw std::runtime_error("Enable to open the file \"" + path + "\"" );
+
+    uint8_t header[33];
+    input.read(reinterpret_cast<char *>(header), 33);
+
+    return probe(header, static_cast<std::size_t>(input.gcount()));
+}
+
+/**
+ * @brief method for retrieving png header informations from a buffer holding(at least) the beginning of a png file
+ * 
+ * @param buffer the png file datas
+ * @param length the buffer length, only the first 33 bytes are used
+ * @return PNG::INFO the png header informations
+ * 
+ * @exception std::runtime_error if the buffer is too short, the signature, the IHDR chunk or its crc32 is invalid
+ */
+PNG::INFO PNG::probe(const uint8_t *buffer, std::size_t length)
+{
+    const uint8_t signature[8] = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+    const uint8_t IHDR[8] = {0x0, 0x0, 0x0, 0xD, 0x49, 0x48, 0x44, 0x52}; // length(13) then type
+
+    if (length < 33)
+        throw std::runtime_error("PNG::probe() - Too short to be a PNG file");
+
+    uint8_t header[33];
+    memcpy(header, buffer, 33);
+
+    if (memcmp(header, signature, 8) != 0)
+        throw std::runtime_error("PNG::probe() - Invalid PNG signature");
+
+    if (memcmp(header + 8, IHDR, 8) != 0)
+        throw std::runtime_error("PNG::probe() - Missing or invalid IHDR chunk");
+
+    // the crc32 is computed on the chunk type and the chunk datas, and stored(big endian) just after the datas
+    const unsigned long crc32 = static_cast<unsigned long>(header[29]) << 24 | static_cast<unsigned long>(header[30]) << 16 |
+                                static_cast<unsigned long>(header[31]) << 8  | static_cast<unsigned long>(header[32]);
+    if (CRC32::getCRC32(header + 12, 4 + 13) != crc32)
+        throw std::runtime_error("PNG::probe() - Invalid IHDR crc32");
+
+    INFO info;
+    info.width = Utilities::uint8_to_int(header + 16);
+    info.height = Utilities::uint8_to_int(header + 20);
+    info.bitDepth = header[24];
+    info.colorMode = header[25];
+    info.compression = header[26];
+    info.filter = header[27];
+    info.interlacing = header[28];
+
+    return info;
+}
+
+/**
+ * @brief method for decoding a png file directly into a caller buffer, without any pixels buffer allocated by the library
+ * @details with FORMAT::ORIGINAL, each line is inflated and unfiltered in place in the destination(see ROW_DECODER::decode_into()),
+ * lines are stored with the png layout(get_width() * bytes per pixel, big endian 16 bits values).
+ * with the other formats, each line is converted(see Formats::convert_line()) into the destination just after being unfiltered,
+ * while it's still in cache : the image is never stored in its png layout.
+ * @note use PNG::probe() for knowing the required destination size.
+ * 
+ * @param path the png file path
+ * @param destination the destination buffer
+ * @param size the destination buffer size
+ * @param stride the distance(in bytes) between two lines in the destination, at least width * bytes per pixel(of the output format)
+ * @param decode_mode the file reading mode, DECODE::MAPPED(default) or DECODE::BUFFERED
+ * @param format the output pixels format, FORMAT::ORIGINAL(default), RGB8, RGBA8, BGR8 or BGRA8
+ * 
+ * @exception std::invalid_argument if the format is not managed
+ * @exception std::invalid_argument if the stride is smaller than a line, or the destination is too small for the image
+ * @exception std::runtime_error if cannot open png file as specified path, or the png is invalid or not managed
+ */
+void PNG::decode_into(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride, int decode_mode, int format)
+{
+    const int formatSize = get_format_size(format);
+    ROW_DECODER decoder(path, decode_mode == DECODE::MAPPED);
+
+    const std::size_t rowLength = formatSize == 0 ? static_cast<std::size_t>(decoder.get_row_length()) : static_cast<std::size_t>(decoder.get_width()) * formatSize;
+    if (stride < rowLength)
+        throw std::invalid_argument("PNG::decode_into() - Stride is smaller than a line");
+
+    if (decoder.get_height() > 0 && size < stride * (decoder.get_height() - 1) + rowLength)
+        throw std::invalid_argument("PNG::decode_into() - Destination buffer too small, " + std::to_string(stride * (decoder.get_height() - 1) + rowLength) + " bytes needed");
+
+    if (formatSize == 0)
+    {
+        decoder.decode_into(destination, stride);
+        return;
+    }
+
+    const int samples = decoder.get_colorChannel() / (decoder.get_bitDepth() / 8);
+    const bool bgr = format == FORMAT::BGR8 || format == FORMAT::BGRA8;
+    for (int i = 0; i < decoder.get_height(); ++i)
+        Formats::convert_line(decoder.next_row(), destination + i * stride, decoder.get_width(), samples, decoder.get_bitDepth(), formatSize, bgr);
+}
+
+/**
+ * @brief method for decoding a rectangle(band of lines, optionally cropped) of a png file into a caller buffer
+ * @details lines before the region are only decoded for unfiltering their successor then discarded, and inflating stops
+ * after the last line of the region : the cost depends on the region position and size, not on the whole image.
+ * 
+ * @param path the png file path
+ * @param destination the destination buffer
+ * @param size the destination buffer size
+ * @param stride the distance(in bytes) between two lines in the destination, at least columns * bytes per pixel
+ * @param first_row the first line of the region
+ * @param rows the number of lines of the region
+ * @param first_column the first column of the region, 0 by default
+ * @param columns the number of columns of the region, -1(default) for all the columns from first_column
+ * @param decode_mode the file reading mode, DECODE::MAPPED(default) or DECODE::BUFFERED
+ * @param format the output pixels format, FORMAT::ORIGINAL(default), RGB8, RGBA8, BGR8 or BGRA8(see PNG::decode_into())
+ * 
+ * @exception std::invalid_argument if the format is not managed
+ * @exception std::out_of_range if the region is not inside the image
+ * @exception std::invalid_argument if the stride is smaller than a region line, or the destination is too small for the region
+ * @exception std::runtime_error if cannot open png file as specified path, or the png is invalid or not managed
+ */
+void PNG::decode_region(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride,
+                        int first_row, int rows, int first_column, int columns, int decode_mode, int format)
+{
+    const int formatSize = get_format_size(format);
+    ROW_DECODER decoder(path, decode_mode == DECODE::MAPPED);
+
+    if (columns == -1)
+        columns = decoder.get_width() - first_column;
+
+    if (first_row < 0 || rows < 0 || first_row > decoder.get_height() - rows ||
+        first_column < 0 || columns < 0 || first_column > decoder.get_width() - columns)
+        throw std::out_of_range("PNG::decode_region() - Region is outside the image");
+
+    const std::size_t pixelSize = decoder.get_colorChannel();
+    const std::size_t regionLength = (formatSize == 0 ? pixelSize : formatSize) * static_cast<std::size_t>(columns);
+    if (stride < regionLength)
+        throw std::invalid_argument("PNG::decode_region() - Stride is smaller than a region line");
+
+    if (rows > 0 && size < stride * (rows - 1) + regionLength)
+        throw std::invalid_argument("PNG::decode_region() - Destination buffer too small, " + std::to_string(stride * (rows - 1) + regionLength) + " bytes needed");
+
+    decoder.skip_rows(first_row);
+
+    if (formatSize != 0) // lines are converted just after being unfiltered
+    {
+        const int samples = decoder.get_colorChannel() / (decoder.get_bitDepth() / 8);
+        const bool bgr = format == FORMAT::BGR8 || format == FORMAT::BGRA8;
+        for (int i = 0; i < rows; ++i)
+            Formats::convert_line(decoder.next_row() + first_column * pixelSize, destination + i * stride, columns, samples, decoder.get_bitDepth(), formatSize, bgr);
+    }
+    else if (columns == decoder.get_width()) // full lines are decoded directly into the destination
+        for (int i = 0; i < rows; ++i)
+            decoder.next_row(destination + i * stride);
+    else
+        for (int i = 0; i < rows; ++i)
+            memcpy(destination + i * stride, decoder.next_row() + first_column * pixelSize, regionLength);
+}
+
+/**
+ * @brief method for decoding a png file at a reduced resolution(1/2, 1/4 or 1/8) into a caller buffer
+ * @details each line is downsampled as soon as it's unfiltered : with SAMPLING::BOX the lines are accumulated per block of scale lines,
+ * so only one accumulation line(output width) is kept in memory, the full resolution image is never stored.
+ * the output is (width + scale - 1) / scale pixels wide and (height + scale - 1) / scale pixels high, incomplete blocks on the right
+ * and bottom edges are averaged on their existing pixels. 16 bits values are kept 16 bits(big endian).
+ * 
+ * @param path the png file path
+ * @param destination the destination buffer
+ * @param size the destination buffer size
+ * @param stride the distance(in bytes) between two lines in the destination, at least output width * bytes per pixel
+ * @param scale the reduction factor : 1, 2, 4 or 8
+ * @param sampling SAMPLING::BOX(default, average) or SAMPLING::POINT
+ * @param decode_mode the file reading mode, DECODE::MAPPED(default) or DECODE::BUFFERED
+ * 
+ * @exception std::invalid_argument if the scale or the sampling method is not managed
+ * @exception std::invalid_argument if the stride is smaller than an output line, or the destination is too small
+ * @exception std::runtime_error if cannot open png file as specified path, or the png is invalid or not managed
+ */
+void PNG::decode_scaled(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride, int scale, int sampling, int decode_mode)
+{
+    if (scale != 1 && scale != 2 && scale != 4 && scale != 8)
+        throw std::invalid_argument("PNG::decode_scaled() - Scale must be 1, 2, 4 or 8");
+
+    if (sampling != SAMPLING::BOX && sampling != SAMPLING::POINT)
+        throw std::invalid_argument("PNG::decode_scaled() - Invalid sampling method");
+
+    ROW_DECODER decoder(path, decode_mode == DECODE::MAPPED);
+
+    const int width = decoder.get_width(), height = decoder.get_height();
+    const int out_width = (width + scale - 1) / scale, out_height = (height + scale - 1) / scale;
+    const int sampleSize = decoder.get_bitDepth() / 8;                // 1 or 2 bytes per value
+    const int samples = decoder.get_colorChannel() / sampleSize;      // values per pixel
+    const std::size_t out_rowLength = static_cast<std::size_t>(out_width) * decoder.get_colorChannel();
+
+    if (stride < out_rowLength)
+        throw std::invalid_argument("PNG::decode_scaled() - Stride is smaller than an output line");
+
+    if (out_height > 0 && size < stride * (out_height - 1) + out_rowLength)
+        throw std::invalid_argument("PNG::decode_scaled() - Destination buffer too small, " + std::to_string(stride * (out_height - 1) + out_rowLength) + " bytes needed");
+
+    // reading a value(8 or 16 bits big endian) of a line, and writing it
+    auto get = [sampleSize](const uint8_t *line, std::size_t i) -> uint32_t
+    {
+        return sampleSize == 1 ? line[i] : (static_cast<uint32_t>(line[2 * i]) << 8 | line[2 * i + 1]);
+    };
+    auto set = [sampleSize](uint8_t *line, std::size_t i, uint32_t value)
+    {
+        if (sampleSize == 1)
+            line[i] = static_cast<uint8_t>(value);
+        else
+        {
+            line[2 * i] = static_cast<uint8_t>(value >> 8);
+            line[2 * i + 1] = static_cast<uint8_t>(value);
+        }
+    };
+
+    std::vector<uint32_t> sums(sampling == SAMPLING::BOX ? static_cast<std::size_t>(out_width) * samples : 0, 0); // block sums of the actual output line
+    for (int y = 0; y < height; ++y)
+    {
+        const uint8_t *line = decoder.next_row();
+        uint8_t *out_line = destination + (y / scale) * stride;
+
+        if (sampling == SAMPLING::POINT)
+        {
+            if (y % scale == 0) // only the first line of each block is sampled
+                for (int x = 0; x < out_width; ++x)
+                    for (int s = 0; s < samples; ++s)
+                        set(out_line, static_cast<std::size_t>(x) * samples + s, get(line, static_cast<std::size_t>(x) * scale * samples + s));
+            continue;
+        }
+
+        for (int x = 0; x < width; ++x) // accumulating the line in its block
+            for (int s = 0; s < samples; ++s)
+                sums[static_cast<std::size_t>(x / scale) * samples + s] += get(line, static_cast<std::size_t>(x) * samples + s);
+
+        if (y % scale == scale - 1 || y == height - 1) // block is complete, output line is the rounded average
+        {
+            const uint32_t block_rows = y % scale + 1;
+            for (int x = 0; x < out_width; ++x)
+            {
+                const uint32_t count = block_rows * std::min(scale, width - x * scale);
+                for (int s = 0; s < samples; ++s)
+                {
+                    uint32_t &sum = sums[static_cast<std::size_t>(x) * samples + s];
+                    set(out_line, static_cast<std::size_t>(x) * samples + s, (sum + count / 2) / count);
+                    sum = 0;
+                }
+            }
+        }
+    }
 }
 
 /**
  * @brief get raw pixels inside a png
+ * @note indexed images give their palette indexes, 1, 2 and 4 bits pixels are stored as given by get_packing().
+ * 16 bits samples are in the decoding byte order(see get_endianness()), get_raw_samples() always gives host ordered samples.
  * 
  * @return uint8_t* raw pixels buffer
  */
@@ -492,13 +1389,7 @@ uint8_t *PNG::get_raw_pixels() const
 {
     using namespace std::literals;
 
-    uint8_t colorChannels {0};
-    colorChannels = m_IHDR->m_data[1] == 0x0 ? 1 * (this->get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x1 ? 2 * (this->get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x2 ? 3 * (this->get_bitDepth() / 8):
-                    m_IHDR->m_data[1] == 0x6 ? 4 * (this->get_bitDepth() / 8): 0;
-
-    int pixels_len = this->m_IHDR->m_width * this->m_IHDR->m_height * colorChannels;  
+    const std::size_t pixels_len = get_pixels_length();
 
     uint8_t *output = nullptr;
     try
@@ -513,3 +1404,111 @@ uint8_t *PNG::get_raw_pixels() const
     std::memcpy(output, this->m_pixelBuffer, pixels_len);
     return output;
 }
+
+/**
+ * @brief get the 16 bits samples inside a png, in the host byte order(whatever the decoding endianness)
+ * 
+ * @return uint16_t* raw samples buffer(width * height * samples per pixel), owned by the caller
+ * 
+ * @exception std::runtime_error if the png bit depth is not 16
+ */
+uint16_t *PNG::get_raw_samples() const
+{
+    using namespace std::literals;
+
+    if (this->get_bitDepth() != 0x10)
+        throw std::runtime_error("PNG::get_raw_samples() - Only 16 bits png have 16 bits samples");
+
+    const std::size_t pixels_len = get_pixels_length();
+
+    uint16_t *output = nullptr;
+    try
+    {
+        output = new uint16_t[pixels_len / 2];
+    }
+    catch(const std::exception &exception)
+    {
+        throw std::runtime_error("Error : no memory avaible for getting PNG raw samples : \n"s + exception.what());
+    }
+
+    std::memcpy(output, this->m_pixelBuffer, pixels_len);
+    if (m_endianness == ENDIANNESS::BIG && !Utilities::is_bigEndian())
+        Formats::swap_16(reinterpret_cast<uint8_t *>(output), pixels_len);
+
+    return output;
+}
+
+/**
+ * @brief get the pixels inside a png expanded to 8 bits RGBA, computed on demand
+ * @details the palette indexes and the gray levels up to 8 bits are expanded through a lookup table(SIMD gather, see Formats::expand_line()),
+ * with the transparency of the tRNS chunk. the other images are converted line by line(see Formats::convert_line()),
+ * 16 bits samples being rounded to 8 bits. the pixels of the 16 bits gray images and of the RGB images matching the transparent
+ * color of the tRNS chunk are made transparent, their samples being compared before the rounding(see Formats::mask_transparent()).
+ * @note the compact pixels buffer is kept as is : an indexed image stays a quarter(or less, packed) of its RGBA size until expanded.
+ * 
+ * @return uint8_t* RGBA pixels buffer(width * height * 4 bytes), owned by the caller
+ */
+uint8_t *PNG::get_rgba_pixels() const
+{
+    using namespace std::literals;
+
+    const int width = this->get_width(), height = this->get_height(), bitDepth = this->get_bitDepth(), colorMode = this->get_colorMode();
+    const std::size_t rgba_len = Utilities::get_buffer_length(width, height, 4);
+
+    uint8_t *output = nullptr;
+    try
+    {
+        output = new uint8_t[rgba_len];
+    }
+    catch(const std::exception &exception)
+    {
+        throw std::runtime_error("Error : no memory avaible for getting PNG RGBA pixels : \n"s + exception.what());
+    }
+
+    if (height == 0)
+        return output;
+
+    const std::size_t rowLength = get_pixels_length() / height, outLength = static_cast<std::size_t>(width) * 4;
+    std::vector<uint8_t> line; // the unpacked(or host ordered) line, when the stored line can't be used directly
+    if (colorMode == 0x3 || (colorMode == 0x0 && bitDepth <= 0x8))
+    {
+        const std::vector<uint8_t> lut = get_lut();
+        const bool packed = bitDepth < 0x8 && m_packing == PACKING::PACKED;
+        line.resize(packed ? width : 0);
+        for (int i = 0; i < height; i++)
+        {
+            const uint8_t *indexes = m_pixelBuffer + i * rowLength;
+            if (packed)
+            {
+                Formats::unpack_line(indexes, line.data(), width, bitDepth);
+                indexes = line.data();
+            }
+            Formats::expand_line(indexes, output + i * outLength, width, lut.data(), bitDepth);
+        }
+        return output;
+    }
+
+    // the transparent color(tRNS chunk) of the gray and RGB images, a 16 bits value per sample
+    uint16_t key[3] = {0, 0, 0};
+    const bool keyed = m_tRNS != nullptr && (colorMode == 0x0 || colorMode == 0x2);
+    for (std::size_t k = 0; keyed && k < m_tRNS->m_datas.size() / 2; k++)
+        key[k] = static_cast<uint16_t>(m_tRNS->m_datas[2 * k] << 8 | m_tRNS->m_datas[2 * k + 1]);
+
+    // png samples are big endian, host ordered samples are swapped back line by line
+    const bool swap16 = m_endianness == ENDIANNESS::NATIVE && bitDepth == 0x10 && !Utilities::is_bigEndian();
+    line.resize(swap16 ? rowLength : 0);
+    for (int i = 0; i < height; i++)
+    {
+        const uint8_t *pixels = m_pixelBuffer + i * rowLength;
+        if (swap16)
+        {
+            memcpy(line.data(), pixels, rowLength);
+            Formats::swap_16(line.data(), rowLength);
+            pixels = line.data();
+        }
+        Formats::convert_line(pixels, output + i * outLength, width, get_samples(colorMode), bitDepth, 4, false);
+        if (keyed)
+            Formats::mask_transparent(pixels, output + i * outLength, width, get_samples(colorMode), bitDepth, key);
+    }
+    return output;
+}
@@ -0,0 +1,275 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "../../include/PNG/Filters.h"
+#include "../../include/PNG/Utilities.h"
+#include "../../include/PNG/ROW_DECODER.h"
+
+
+/**
+ * @brief Construct a new ROW_DECODER::ROW_DECODER object
+ * @details only the png header is parsed, the lines are inflated and unfiltered on demand.
+ *
+ * @param path the file path of the png file to read
+ * @param try_mapping if the file should be memory mapped(when possible)
+ *
+ * @exception std::runtime_error if cannot open png file as specified path
+ * @exception std::runtime_error if the png header is invalid or not managed
+ * @exception std::runtime_error if there's no IDAT chunk
+ */
+ROW_DECODER::ROW_DECODER(const std::string &path, bool try_mapping) : m_input(path, try_mapping), m_chunks(m_input), m_inflater(m_input, m_chunks)
+{
+    read_header();
+
+    m_lines.assign(2 * static_cast<std::size_t>(m_rowLength), 0x0);
+    m_prevLine = m_lines.data() + m_rowLength; // the line before the first one is considered as zeros
+}
+
+/**
+ * @brief Destroy the ROW_DECODER::ROW_DECODER object
+ *
+ */
+ROW_DECODER::~ROW_DECODER()
+{
+}
+
+/**
+ * @brief method for parsing the IHDR chunk
+ *
+ * @exception std::runtime_error if IHDR chunk is missing or invalid
+ * @exception std::runtime_error if bit depth is different than 8 or 16
+ * @exception std::runtime_error if color mode is diffrent than 0(grayscale), 4(grayscale with alpha), 2(RGB), 6(RGBA)
+ * @exception std::runtime_error if the png is interlaced
+ * @exception std::overflow_error if a line is longer than INT_MAX bytes
+ */
+void ROW_DECODER::read_header()
+{
+    // the header chunk must be the first chunk of the file
+    const CHUNK_INDEX::ENTRY *IHDR = m_chunks.find("IHDR");
+    if (IHDR == nullptr || IHDR != &m_chunks.get_entries().front() || IHDR->length != 13)
+        throw std::runtime_error("ROW_DECODER::read_header() - Missing or invalid IHDR chunk");
+
+    std::vector<uint8_t> buffer;
+    uint8_t header[13]; // width(4 bytes), height(4 bytes), bit depth, color mode, compression, filter, interlace
+    memcpy(header, m_input.read(IHDR->offset, 13, buffer), 13);
+
+    m_width = Utilities::uint8_to_int(header);
+    m_height = Utilities::uint8_to_int(header + 4);
+
+    m_bitDepth = header[8];
+    if (m_bitDepth != 0x8 && m_bitDepth != 0x10)
+        throw std::runtime_error("Invalid PNG bit depth, must be 8 or 16");
+
+    const int channel_size = m_bitDepth / 8; // represents in how many bytes values are stored for each channel.
+    m_colorMode = header[9];
+    m_colorChannel = m_colorMode == 0x0 ? 1 * channel_size :
+                     m_colorMode == 0x4 ? 2 * channel_size :
+                     m_colorMode == 0x2 ? 3 * channel_size :
+                     m_colorMode == 0x6 ? 4 * channel_size : 0;
+    if (m_colorChannel == 0)
+        throw std::runtime_error("Only Color modes 0(grayscale), 4(grayscale with alpha), 2(RGB true color) and 6(RGBA) are managed");
+
+    if (header[12] != 0x0)
+        throw std::runtime_error("ROW_DECODER::read_header() - Interlaced PNG are not managed");
+
+    m_rowLength = static_cast<int>(Utilities::get_buffer_length(m_width, 1, m_colorChannel)); // checking the line length overflow
+}
+
+/**
+ * @brief get png width
+ *
+ * @return int
+ */
+int ROW_DECODER::get_width() const noexcept
+{
+    return m_width;
+}
+
+/**
+ * @brief get png height
+ *
+ * @return int
+ */
+int ROW_DECODER::get_height() const noexcept
+{
+    return m_height;
+}
+
+/**
+ * @brief get png bit depth
+ *
+ * @return uint8_t
+ */
+uint8_t ROW_DECODER::get_bitDepth() const noexcept
+{
+    return m_bitDepth;
+}
+
+/**
+ * @brief get png color mode
+ *
+ * @return uint8_t
+ */
+uint8_t ROW_DECODER::get_colorMode() const noexcept
+{
+    return m_colorMode;
+}
+
+/**
+ * @brief get the number of bytes per pixel
+ *
+ * @return uint8_t
+ */
+uint8_t ROW_DECODER::get_colorChannel() const noexcept
+{
+    return m_colorChannel;
+}
+
+/**
+ * @brief get the number of bytes of an unfiltered line
+ *
+ * @return int
+ */
+int ROW_DECODER::get_row_length() const noexcept
+{
+    return m_rowLength;
+}
+
+/**
+ * @brief get the index of the next line to decode
+ *
+ * @return int, equals to the png height when all the lines are decoded
+ */
+int ROW_DECODER::get_row() const noexcept
+{
+    return m_row;
+}
+
+/**
+ * @brief if the png file is memory mapped
+ *
+ * @return bool
+ */
+bool ROW_DECODER::is_mapped() const noexcept
+{
+    return m_input.is_mapped();
+}
+
+/**
+ * @brief method for inflating and unfiltering the next line
+ * @details the line is inflated directly in its destination then unfiltered in place, and becomes the previous line.
+ *
+ * @param line the line destination(get_row_length() bytes), must not be the previous line
+ */
+void ROW_DECODER::decode_row(uint8_t *line)
+{
+    uint8_t filterMode(0);
+    m_inflater.read(&filterMode, 1);
+    m_inflater.read(line, m_rowLength);
+    Filters::unfilter_line(line, m_rowLength, filterMode, m_prevLine, m_colorChannel);
+
+    m_prevLine = line;
+    if (++m_row == m_height)
+        m_inflater.finish(); // checking the adler32 checksum
+}
+
+/**
+ * @brief method for decoding the next line
+ *
+ * @return either nullptr if all the lines are already decoded or the unfiltered line(get_row_length() bytes),
+ * valid until the next call
+ *
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+const uint8_t *ROW_DECODER::next_row()
+{
+    if (m_row == m_height)
+        return nullptr;
+
+    // the two internal lines are used alternately, the other one being the previous line(no copy)
+    uint8_t *line = (m_prevLine == m_lines.data()) ? m_lines.data() + m_rowLength : m_lines.data();
+    decode_row(line);
+
+    return line;
+}
+
+/**
+ * @brief method for decoding the next line directly into a caller buffer
+ * @warning the output line is used as the previous line for unfiltering the next one, so it must stay unchanged
+ * until the next line is decoded.
+ *
+ * @param output the output line, at least get_row_length() bytes
+ *
+ * @exception std::out_of_range if all the lines are already decoded
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+void ROW_DECODER::next_row(uint8_t *output)
+{
+    if (m_row == m_height)
+        throw std::out_of_range("ROW_DECODER::next_row() - All the lines are already decoded");
+
+    decode_row(output);
+}
+
+/**
+ * @brief method for decoding a strip of lines
+ * @details the lines are decoded directly in the output buffer, only the last one is copied internally
+ * (it's the previous line of the next strip, and the output buffer may be reused by the caller).
+ *
+ * @param output the output buffer, at least rows * get_row_length() bytes
+ * @param rows the number of lines to decode
+ * @return the number of lines effectively decoded, less than rows at the end of the png
+ */
+int ROW_DECODER::read_rows(uint8_t *output, int rows)
+{
+    int i(0);
+    for (i = 0; i < rows && m_row < m_height; i++)
+        decode_row(output + static_cast<std::size_t>(i) * m_rowLength);
+
+    if (i > 0)
+    {
+        memcpy(m_lines.data(), m_prevLine, m_rowLength);
+        m_prevLine = m_lines.data();
+    }
+    return i;
+}
+
+/**
+ * @brief method for skipping lines
+ * @note png lines can't be skipped without being inflated and unfiltered(each line is needed for unfiltering the next one),
+ * but skipped lines are only decoded in the internal lines, never copied.
+ *
+ * @param rows the number of lines to skip
+ * @return the number of lines effectively skipped, less than rows at the end of the png
+ */
+int ROW_DECODER::skip_rows(int rows)
+{
+    int i(0);
+    for (i = 0; i < rows && next_row() != nullptr; i++)
+        ;
+
+    return i;
+}
+
+/**
+ * @brief method for decoding all the remaining lines directly into a caller buffer
+ * @details each line is inflated and unfiltered in place in the destination, using the previous destination line,
+ * no line is copied.
+ *
+ * @param destination the first remaining line destination
+ * @param stride the distance(in bytes) between two lines in the destination, at least get_row_length()
+ *
+ * @exception std::invalid_argument if stride is smaller than a line
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ * @exception std::invalid_argument case Invalid filter mode
+ */
+void ROW_DECODER::decode_into(uint8_t *destination, std::size_t stride)
+{
+    if (stride < static_cast<std::size_t>(m_rowLength))
+        throw std::invalid_argument("ROW_DECODER::decode_into() - Stride is smaller than a line");
+
+    for (; m_row < m_height; destination += stride)
+        decode_row(destination);
+}
@@ -0,0 +1,402 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../../include/zlib/zlib.h"
+#include "../../include/PNG/Filters.h"
+#include "../../include/PNG/INFLATER.h"
+#include "../../include/PNG/Utilities.h"
+#include "../../include/PNG/ROW_INDEX.h"
+#include "../../include/PNG/INPUT_FILE.h"
+#include "../../include/PNG/Chunks/CHUNK_INDEX.h"
+
+
+/**
+ * @brief Construct a new ROW_INDEX::ROW_INDEX object, indexing a png file
+ * @details the whole deflate stream is inflated once, in a 32 KB circular window, and the lines are unfiltered as soon as complete.
+ * a checkpoint is recorded at the first deflate block boundary of each spacing lines(block boundaries don't match lines boundaries,
+ * so the checkpoints are at least spacing lines apart, and the lines density depends on the deflate blocks size).
+ *
+ * @param path the png file path
+ * @param spacing the minimal number of lines between two checkpoints
+ * @param try_mapping if the file should be memory mapped(when possible)
+ *
+ * @exception std::invalid_argument if spacing is not positive
+ * @exception std::runtime_error if cannot open png file as specified path
+ * @exception std::runtime_error if the png header is invalid or not managed
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ */
+ROW_INDEX::ROW_INDEX(const std::string &path, int spacing, bool try_mapping) : m_spacing(spacing)
+{
+    if (spacing <= 0)
+        throw std::invalid_argument("ROW_INDEX::ROW_INDEX() - Spacing must be positive");
+
+    INPUT_FILE input(path, try_mapping);
+    CHUNK_INDEX chunks(input);
+
+    // the header chunk must be the first chunk of the file
+    const CHUNK_INDEX::ENTRY *IHDR = chunks.find("IHDR");
+    if (IHDR == nullptr || IHDR != &chunks.get_entries().front() || IHDR->length != 13)
+        throw std::runtime_error("ROW_INDEX::ROW_INDEX() - Missing or invalid IHDR chunk");
+
+    std::vector<uint8_t> buffer;
+    set_header(input.read(IHDR->offset, 13, buffer));
+    m_fileSize = input.get_size();
+
+    INFLATER inflater(input, chunks);
+    const std::size_t lineLength = 1 + static_cast<std::size_t>(m_rowLength); // scanline length, with the filter byte
+    const uint64_t total = lineLength * m_height;
+
+    std::vector<uint8_t> window(32768); // circular window, the deflate maximal distance
+    std::size_t windowPos(0);
+    bool windowFull(false);
+
+    std::vector<uint8_t> line(lineLength), prevRow(m_rowLength, 0x0);
+    std::size_t linePos(0);
+    uint64_t output(0);
+    uint64_t nextRow(0); // the first line of the next checkpoint
+
+    while (output < total)
+    {
+        if (windowPos == window.size())
+        {
+            windowPos = 0;
+            windowFull = true;
+        }
+
+        const std::size_t inflated = inflater.read_block(window.data() + windowPos, std::min<uint64_t>(window.size() - windowPos, total - output));
+        if (inflated == 0 && !inflater.is_block_boundary())
+            throw std::runtime_error("ROW_INDEX::ROW_INDEX() - IDAT datas end before all the scanlines are inflated");
+
+        // the inflated bytes are gathered in lines, unfiltered as soon as complete
+        for (std::size_t i = 0; i < inflated;)
+        {
+            const std::size_t n = std::min(inflated - i, lineLength - linePos);
+            memcpy(line.data() + linePos, window.data() + windowPos + i, n);
+            linePos += n;
+            i += n;
+
+            if (linePos == lineLength)
+            {
+                Filters::unfilter_line(line.data() + 1, m_rowLength, line[0], prevRow.data(), m_colorChannel);
+                memcpy(prevRow.data(), line.data() + 1, m_rowLength);
+                linePos = 0;
+            }
+        }
+        windowPos += inflated;
+        output += inflated;
+
+        if (inflater.is_block_boundary() && output < total && output / lineLength >= nextRow)
+        {
+            CHECKPOINT checkpoint;
+            checkpoint.position = inflater.get_position();
+            checkpoint.bits = static_cast<uint8_t>(inflater.get_bits());
+            checkpoint.output = output;
+
+            // the window is unrolled, from the oldest byte to the last one
+            checkpoint.window.assign(window.begin() + (windowFull ? windowPos : 0), windowFull ? window.end() : window.begin() + windowPos);
+            if (windowFull)
+                checkpoint.window.insert(checkpoint.window.end(), window.begin(), window.begin() + windowPos);
+
+            checkpoint.prevRow = prevRow;
+            checkpoint.partialRow.assign(line.begin(), line.begin() + linePos);
+            m_checkpoints.push_back(std::move(checkpoint));
+
+            nextRow = output / lineLength + m_spacing;
+        }
+    }
+
+    inflater.finish(); // checking the adler32 checksum, an index of a corrupted file would be useless
+}
+
+/**
+ * @brief Construct an empty ROW_INDEX::ROW_INDEX object, filled by load()
+ *
+ */
+ROW_INDEX::ROW_INDEX()
+{
+}
+
+/**
+ * @brief Destroy the ROW_INDEX::ROW_INDEX object
+ *
+ */
+ROW_INDEX::~ROW_INDEX()
+{
+}
+
+/**
+ * @brief method for parsing the IHDR chunk datas
+ *
+ * @param header the IHDR chunk datas(13 bytes)
+ *
+ * @exception std::runtime_error if bit depth is different than 8 or 16
+ * @exception std::runtime_error if color mode is diffrent than 0(grayscale), 4(grayscale with alpha), 2(RGB), 6(RGBA)
+ * @exception std::runtime_error if the png is interlaced
+ * @exception std::overflow_error if a line is longer than INT_MAX bytes
+ */
+void ROW_INDEX::set_header(const uint8_t *header)
+{
+    memcpy(m_header, header, 13);
+    m_width = Utilities::uint8_to_int(m_header);
+    m_height = Utilities::uint8_to_int(m_header + 4);
+
+    if (m_header[8] != 0x8 && m_header[8] != 0x10)
+        throw std::runtime_error("Invalid PNG bit depth, must be 8 or 16");
+
+    const int channel_size = m_header[8] / 8;
+    m_colorChannel = m_header[9] == 0x0 ? 1 * channel_size :
+                     m_header[9] == 0x4 ? 2 * channel_size :
+                     m_header[9] == 0x2 ? 3 * channel_size :
+                     m_header[9] == 0x6 ? 4 * channel_size : 0;
+    if (m_colorChannel == 0)
+        throw std::runtime_error("Only Color modes 0(grayscale), 4(grayscale with alpha), 2(RGB true color) and 6(RGBA) are managed");
+
+    if (m_header[12] != 0x0)
+        throw std::runtime_error("ROW_INDEX::set_header() - Interlaced PNG are not managed");
+
+    m_rowLength = static_cast<int>(Utilities::get_buffer_length(m_width, 1, m_colorChannel)); // checking the line length overflow
+}
+
+/**
+ * @brief get png width
+ *
+ * @return int
+ */
+int ROW_INDEX::get_width() const noexcept
+{
+    return m_width;
+}
+
+/**
+ * @brief get png height
+ *
+ * @return int
+ */
+int ROW_INDEX::get_height() const noexcept
+{
+    return m_height;
+}
+
+/**
+ * @brief get the number of bytes of an unfiltered line
+ *
+ * @return int
+ */
+int ROW_INDEX::get_row_length() const noexcept
+{
+    return m_rowLength;
+}
+
+/**
+ * @brief get the minimal number of lines between two checkpoints
+ *
+ * @return int
+ */
+int ROW_INDEX::get_spacing() const noexcept
+{
+    return m_spacing;
+}
+
+/**
+ * @brief get the checkpoints
+ *
+ * @return const std::vector<ROW_INDEX::CHECKPOINT>&
+ */
+const std::vector<ROW_INDEX::CHECKPOINT> &ROW_INDEX::get_checkpoints() const noexcept
+{
+    return m_checkpoints;
+}
+
+/**
+ * @brief method for decoding lines of the indexed png file into a caller buffer
+ * @details the inflate restarts at the last checkpoint before the first line, so at most the lines between two checkpoints
+ * are decoded before the first requested line.
+ *
+ * @param path the indexed png file path
+ * @param destination the destination buffer
+ * @param size the destination buffer size
+ * @param stride the distance(in bytes) between two lines in the destination, at least get_row_length()
+ * @param first_row the first line to decode
+ * @param rows the number of lines to decode
+ * @param try_mapping if the file should be memory mapped(when possible)
+ *
+ * @exception std::out_of_range if the lines are outside the image
+ * @exception std::invalid_argument if the stride is smaller than a line, or the destination is too small
+ * @exception std::runtime_error if cannot open png file as specified path, or the index doesn't match the png file
+ * @exception std::runtime_error if IDAT datas are corrupted or truncated
+ */
+void ROW_INDEX::decode_rows(const std::string &path, uint8_t *destination, std::size_t size, std::size_t stride,
+                            int first_row, int rows, bool try_mapping) const
+{
+    if (first_row < 0 || rows < 0 || first_row > m_height - rows)
+        throw std::out_of_range("ROW_INDEX::decode_rows() - Lines are outside the image");
+
+    if (stride < static_cast<std::size_t>(m_rowLength))
+        throw std::invalid_argument("ROW_INDEX::decode_rows() - Stride is smaller than a line");
+
+    if (rows > 0 && size < stride * (rows - 1) + m_rowLength)
+        throw std::invalid_argument("ROW_INDEX::decode_rows() - Destination buffer too small, " + std::to_string(stride * (rows - 1) + m_rowLength) + " bytes needed");
+
+    INPUT_FILE input(path, try_mapping);
+    CHUNK_INDEX chunks(input);
+
+    std::vector<uint8_t> buffer;
+    const CHUNK_INDEX::ENTRY *IHDR = chunks.find("IHDR");
+    if (input.get_size() != m_fileSize || IHDR == nullptr || IHDR->length != 13 || memcmp(input.read(IHDR->offset, 13, buffer), m_header, 13) != 0)
+        throw std::runtime_error("ROW_INDEX::decode_rows() - The index doesn't match the png file " + path);
+
+    INFLATER inflater(input, chunks);
+    const std::size_t lineLength = 1 + static_cast<std::size_t>(m_rowLength);
+    std::vector<uint8_t> line(lineLength), prevRow(m_rowLength, 0x0);
+    std::size_t linePos(0);
+    int row(0);
+
+    // the last checkpoint inside a line before the first line(or inside the first line)
+    auto checkpoint = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), (first_row + 1) * lineLength - 1,
+                                       [](uint64_t output, const CHECKPOINT &c) { return output < c.output; });
+    if (checkpoint != m_checkpoints.begin())
+    {
+        --checkpoint;
+        inflater.seek(checkpoint->position, checkpoint->bits, checkpoint->window.data(), checkpoint->window.size());
+        prevRow = checkpoint->prevRow;
+        std::copy(checkpoint->partialRow.begin(), checkpoint->partialRow.end(), line.begin());
+        linePos = checkpoint->partialRow.size();
+        row = static_cast<int>(checkpoint->output / lineLength);
+    }
+
+    for (; row < first_row + rows; ++row)
+    {
+        inflater.read(line.data() + linePos, lineLength - linePos);
+        linePos = 0;
+
+        Filters::unfilter_line(line.data() + 1, m_rowLength, line[0], prevRow.data(), m_colorChannel);
+        memcpy(prevRow.data(), line.data() + 1, m_rowLength);
+
+        if (row >= first_row)
+            memcpy(destination + (row - first_row) * stride, prevRow.data(), m_rowLength);
+    }
+}
+
+/**
+ * @brief save the index as a binary file, typically next to the png file
+ * @details all the integers are big endian(as in png files) :
+ * - header : "PNGR" magic, version(4 bytes), png file size(8 bytes), png IHDR datas(13 bytes), spacing(4 bytes), checkpoints count(4 bytes)
+ * - each checkpoint : position(8 bytes), bits(1 byte), output(8 bytes), window length(4 bytes), compressed length(4 bytes),
+ * then the window, the previous line and the partial line, compressed together(zlib)
+ *
+ * @param path the index file path
+ *
+ * @exception std::runtime_error if cannot create file as specified path
+ */
+void ROW_INDEX::save(const std::string &path) const
+{
+    std::ofstream output_stream(path, std::ios::out | std::ios::binary);
+    if (!output_stream.is_open())
+        throw std::runtime_error("ROW_INDEX::save() - Enable to create file at specified path : " + path);
+
+    std::string out("PNGR");
+    auto put = [&out](uint64_t value, int bytes) // big endian writing
+    {
+        for (int i = bytes - 1; i >= 0; --i)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    };
+
+    put(1, 4); // version
+    put(m_fileSize, 8);
+    out.append(reinterpret_cast<const char *>(m_header), 13);
+    put(m_spacing, 4);
+    put(m_checkpoints.size(), 4);
+
+    std::vector<uint8_t> datas, compressed;
+    for (const auto &checkpoint : m_checkpoints)
+    {
+        datas = checkpoint.window;
+        datas.insert(datas.end(), checkpoint.prevRow.begin(), checkpoint.prevRow.end());
+        datas.insert(datas.end(), checkpoint.partialRow.begin(), checkpoint.partialRow.end());
+
+        uLongf compressedLen = compressBound(datas.size());
+        compressed.resize(compressedLen);
+        if (compress(compressed.data(), &compressedLen, datas.data(), datas.size()) != Z_OK)
+            throw std::runtime_error("ROW_INDEX::save() - Enable to compress a checkpoint");
+
+        put(checkpoint.position, 8);
+        put(checkpoint.bits, 1);
+        put(checkpoint.output, 8);
+        put(checkpoint.window.size(), 4);
+        put(compressedLen, 4);
+        out.append(reinterpret_cast<const char *>(compressed.data()), compressedLen);
+
+        output_stream.write(out.data(), out.size()); // checkpoints are written one by one
+        out.clear();
+    }
+    output_stream.write(out.data(), out.size());
+}
+
+/**
+ * @brief method for loading an index saved by save()
+ *
+ * @param path the index file path
+ * @return ROW_INDEX the loaded index
+ *
+ * @exception std::runtime_error if cannot open the index file as specified path
+ * @exception std::runtime_error if the file is not a valid index file
+ */
+ROW_INDEX ROW_INDEX::load(const std::string &path)
+{
+    std::ifstream input_stream(path, std::ios::in | std::ios::binary);
+    if (!input_stream.is_open())
+        throw std::runtime_error("ROW_INDEX::load() - Enable to open file at specified path : " + path);
+
+    const std::vector<uint8_t> in((std::istreambuf_iterator<char>(input_stream)), std::istreambuf_iterator<char>());
+    std::size_t pos(0);
+    auto get = [&in, &pos](int bytes) -> uint64_t // big endian reading
+    {
+        if (in.size() - pos < static_cast<std::size_t>(bytes))
+            throw std::runtime_error("ROW_INDEX::load() - Truncated index file");
+
+        uint64_t value(0);
+        for (int i = 0; i < bytes; ++i)
+            value = value << 8 | in[pos++];
+        return value;
+    };
+
+    if (get(4) != 0x504E4752 || get(4) != 1) // "PNGR", version 1
+        throw std::runtime_error("ROW_INDEX::load() - Not an index file, or unknown version");
+
+    ROW_INDEX index;
+    index.m_fileSize = get(8);
+    uint8_t header[13];
+    for (auto &byte : header)
+        byte = static_cast<uint8_t>(get(1));
+    index.set_header(header);
+    index.m_spacing = static_cast<int>(get(4));
+
+    const std::size_t lineLength = 1 + static_cast<std::size_t>(index.m_rowLength);
+    const uint64_t count = get(4);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        CHECKPOINT checkpoint;
+        checkpoint.position = get(8);
+        checkpoint.bits = static_cast<uint8_t>(get(1));
+        checkpoint.output = get(8);
+        const uint64_t windowLen = get(4), compressedLen = get(4);
+        if (windowLen > 32768 || checkpoint.bits > 7 || in.size() - pos < compressedLen)
+            throw std::runtime_error("ROW_INDEX::load() - Invalid checkpoint");
+
+        const std::size_t partialLen = checkpoint.output % lineLength;
+        std::vector<uint8_t> datas(windowLen + index.m_rowLength + partialLen);
+        uLongf datasLen = datas.size();
+        if (uncompress(datas.data(), &datasLen, in.data() + pos, compressedLen) != Z_OK || datasLen != datas.size())
+            throw std::runtime_error("ROW_INDEX::load() - Invalid checkpoint");
+        pos += compressedLen;
+
+        checkpoint.window.assign(datas.begin(), datas.begin() + windowLen);
+        checkpoint.prevRow.assign(datas.begin() + windowLen, datas.begin() + windowLen + index.m_rowLength);
+        checkpoint.partialRow.assign(datas.begin() + windowLen + index.m_rowLength, datas.end());
+        index.m_checkpoints.push_back(std::move(checkpoint));
+    }
+    return index;
+}
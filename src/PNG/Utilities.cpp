@@ -1,4 +1,7 @@
 
+#include <climits>
+#include <stdexcept>
+
 #include "../../include/PNG/Utilities.h"
 
 /**
@@ -7,18 +10,19 @@
  * @param number the number to convert
  * @return the pointer to the converted array
  */
-uint8_t *Utilities::int_to_uint8(int number)
+uint8_t *Utilities::int_to_uint8(uint32_t number)
 {
     uint8_t *ptr = reinterpret_cast<uint8_t *>(&number);
     uint8_t *result(nullptr);
 
-    if (is_bigEndian())
-        result = ptr;
-    else
+    if (is_bigEndian()) // the caller owns(and frees) the result, so it can't point to the local number
     {
-        result = invertArray(ptr, 4);
-        delete[] ptr;
+        result = new uint8_t[4];
+        memcpy(result, ptr, 4);
     }
+    else
+        result = invertArray(ptr, 4);
+
     return result;
 }
 
@@ -44,10 +48,10 @@ int Utilities::uint8_to_int(uint8_t *ptr)
  * @param len the input array size
  * @return a pointer to the inverted array
  */
-uint8_t *Utilities::invertArray(uint8_t *array, int len)
+uint8_t *Utilities::invertArray(uint8_t *array, std::size_t len)
 {
     uint8_t *invertedArray = new uint8_t[len];
-    for (int i = 0; i < len; i++)
+    for (std::size_t i = 0; i < len; i++)
         invertedArray[i] = array[len - i - 1];
     return invertedArray;
 }
@@ -61,7 +65,7 @@ uint8_t *Utilities::invertArray(uint8_t *array, int len)
  * @param len2 the second input array size
  * @return a pointer to the concated array result
  */
-uint8_t *Utilities::getConcatenedArray(uint8_t *array1, uint8_t *array2, int len1, int len2)
+uint8_t *Utilities::getConcatenedArray(uint8_t *array1, uint8_t *array2, std::size_t len1, std::size_t len2)
 {
     uint8_t *concatenedArray = new uint8_t[len1 + len2];
     memcpy(concatenedArray, array1, len1);
@@ -91,12 +95,12 @@ bool Utilities::is_bigEndian(void)
  * @param input the input file stream
  * @return the file length
  */
-int Utilities::f_len(std::ifstream &input)
+int64_t Utilities::f_len(std::ifstream &input)
 {
-    int prev_pos = input.tellg(); // storing the initial cursor position
+    std::streamoff prev_pos = input.tellg(); // storing the initial cursor position
     input.seekg(0, std::ios::end);
 
-    int total_len(input.tellg());    // calculating the length
+    int64_t total_len(input.tellg());    // calculating the length
     input.seekg(prev_pos, std::ios::beg); // restoring the initial cursor position
     return total_len;
 }
@@ -108,14 +112,15 @@ int Utilities::f_len(std::ifstream &input)
   @param limit the limit length inwhich to search the word, default = 0 occurs research in the limit specified length
   @return -1 either the string is not found or the word position(word included)
  */
-int Utilities::f_strchr(std::ifstream &input, std::string word, int limit)
+int64_t Utilities::f_strchr(std::ifstream &input, std::string word, int64_t limit)
 {
-    int prev_pos = input.tellg(); // saving the previous cursor position
+    std::streamoff prev_pos = input.tellg(); // saving the previous cursor position
     input.seekg(0, std::ios::beg);     
 
     bool is_found(false);
     uint8_t actual(0);
-    std::size_t i(0), j(0);
+    int64_t i(0);
+    std::size_t j(0);
 
     if (!limit) // if the limits is defaut (0), we'll search word in entire file 
         limit = f_len(input);
@@ -136,7 +141,7 @@ int Utilities::f_strchr(std::ifstream &input, std::string word, int limit)
     }
     input.seekg(prev_pos, std::ios::beg); // re-placing the cursor at its previous position
     if (is_found && j == word.size())
-        return (i - word.size());
+        return (i - static_cast<int64_t>(word.size()));
 
     return -1;
 }
@@ -147,21 +152,21 @@ int Utilities::f_strchr(std::ifstream &input, std::string word, int limit)
   @param word the string to search
   @return a vector including positions of specified word occurences
  */
-std::vector<int> Utilities::f_strchr(std::ifstream &input, const std::string word)
+std::vector<int64_t> Utilities::f_strchr(std::ifstream &input, const std::string word)
 {
-    int prev_pos = input.tellg(); // saving the previous cursor position
+    std::streamoff prev_pos = input.tellg(); // saving the previous cursor position
     input.seekg(0, std::ios::beg);
 
-    std::vector<int> positions; 
-    int pos(0), i(0);
+    std::vector<int64_t> positions; 
+    int64_t pos(0), i(0);
 
     do
     {
         bool is_found(false);
         uint8_t actual(0);
-        int j(0);
+        std::size_t j(0);
 
-        int limit = f_len(input);                      
+        int64_t limit = f_len(input);                      
         for (j = 0; i < limit && j < word.size(); i++) 
         {
             input >> std::noskipws >> actual;   // reading, disabling specials caracters skipping 
@@ -180,7 +185,7 @@ std::vector<int> Utilities::f_strchr(std::ifstream &input, const std::string wor
         // if an occurence is found, we store it position in the vector
         if (is_found && j == word.size())
         {
-            pos = i - word.size();
+            pos = i - static_cast<int64_t>(word.size());
             positions.push_back(pos);
         }
         // else we indicate there's no others occurences after this
@@ -203,13 +208,18 @@ std::vector<int> Utilities::f_strchr(std::ifstream &input, const std::string wor
  */
 void Utilities::flipPixels(uint8_t *pixelsBuffer, int s_width, int s_heigth, int colorChannel)
 {
-    int totalLength = s_width * s_heigth * colorChannel;
-    int oneLineLength = s_width * colorChannel;
+    const std::size_t oneLineLength = static_cast<std::size_t>(s_width) * colorChannel;
 
-    uint8_t *tmp = new uint8_t[totalLength];
-    memcpy(tmp, pixelsBuffer, totalLength);
-    for (int i = 0; i < s_heigth; i++)
-        memcpy(pixelsBuffer + oneLineLength * i, tmp + totalLength - oneLineLength * (i + 1), oneLineLength);
+    // swapping the lines two by two, through a single line buffer
+    uint8_t *tmp = new uint8_t[oneLineLength];
+    for (int i = 0; i < s_heigth / 2; i++)
+    {
+        uint8_t *top = pixelsBuffer + oneLineLength * i;
+        uint8_t *bottom = pixelsBuffer + oneLineLength * (s_heigth - i - 1);
+        memcpy(tmp, top, oneLineLength);
+        memcpy(top, bottom, oneLineLength);
+        memcpy(bottom, tmp, oneLineLength);
+    }
     delete[] tmp;
 }
 
@@ -242,36 +252,107 @@ int Utilities::paeth_predictor(uint8_t left, uint8_t up, uint8_t upperLeft)
  * @param src_size the source buffer size
  * @param ouputStream the file stream in which to write
  */
-void Utilities::stream_write(const uint8_t *src, int src_size, std::ofstream &ouputStream)
+void Utilities::stream_write(const uint8_t *src, std::size_t src_size, std::ofstream &ouputStream)
 {
-    for (int i = 0; i < src_size; i++)
-        ouputStream << std::noskipws << src[i];
+    ouputStream.write(reinterpret_cast<const char *>(src), static_cast<std::streamsize>(src_size));
 }
 
 
 /**
- * @brief Method for counting the number of elements(without redundance) inside an input buffer. 
- * 
+ * @brief Method for counting the number of elements(without redundance) inside an input buffer.
+ * @details each value sets its bit in a 256 bits set, 4 sets are used alternately so that consecutive bytes don't wait
+ * on each other, the count stops early once all the values are found.
+ *
  * @param buffer input buffer
  * @param buffer_len input buffer size
  * @return int the number differents values inside the buffer
  */
-int Utilities::get_cardinal(uint8_t *buffer, int buffer_len) noexcept
-{       
-    std::vector<uint8_t> computed;
-    for(int i = 0; i < buffer_len; ++i)
+int Utilities::get_cardinal(const uint8_t *buffer, std::size_t buffer_len) noexcept
+{
+    uint64_t sets[4][4] = {{0}};
+    std::size_t i(0);
+    while (i + 4 <= buffer_len)
     {
-        bool compute = true;
-        for(auto value : computed)
-            if(buffer[i] == value)
-            {
-                compute = false;
-                break;
-            }
- 
-        if(compute)
-            computed.push_back(buffer[i]);
+        // checking every 256 bytes if all the values are already found
+        const std::size_t stop = (buffer_len - i) / 4 > 64 ? i + 256 : buffer_len - (buffer_len - i) % 4;
+        for (; i < stop; i += 4)
+        {
+            sets[0][buffer[i] >> 6] |= 1ULL << (buffer[i] & 63);
+            sets[1][buffer[i + 1] >> 6] |= 1ULL << (buffer[i + 1] & 63);
+            sets[2][buffer[i + 2] >> 6] |= 1ULL << (buffer[i + 2] & 63);
+            sets[3][buffer[i + 3] >> 6] |= 1ULL << (buffer[i + 3] & 63);
+        }
+
+        if ((sets[0][0] | sets[1][0] | sets[2][0] | sets[3][0]) == UINT64_MAX && (sets[0][1] | sets[1][1] | sets[2][1] | sets[3][1]) == UINT64_MAX &&
+            (sets[0][2] | sets[1][2] | sets[2][2] | sets[3][2]) == UINT64_MAX && (sets[0][3] | sets[1][3] | sets[2][3] | sets[3][3]) == UINT64_MAX)
+            return 256;
+    }
+    for (; i < buffer_len; ++i)
+        sets[0][buffer[i] >> 6] |= 1ULL << (buffer[i] & 63);
+
+    int cardinal(0);
+    for (int j = 0; j < 4; ++j)
+        cardinal += __builtin_popcountll(sets[0][j] | sets[1][j] | sets[2][j] | sets[3][j]);
+
+    return cardinal;
+}
+
+/**
+ * @brief Method for counting the occurrences of each value inside an input buffer.
+ * @details 4 partial histograms are used alternately so that consecutive equal bytes don't wait on each other's increment,
+ * then summed(vectorized by the compiler).
+ *
+ * @param buffer input buffer
+ * @param buffer_len input buffer size(up to UINT32_MAX)
+ * @param histogram the output histogram, 256 counts
+ * @return int the number differents values inside the buffer(the non zero counts)
+ */
+int Utilities::get_histogram(const uint8_t *buffer, std::size_t buffer_len, uint32_t *histogram) noexcept
+{
+    uint32_t partial[4][256] = {{0}};
+    std::size_t i(0);
+    for (; i + 4 <= buffer_len; i += 4)
+    {
+        ++partial[0][buffer[i]];
+        ++partial[1][buffer[i + 1]];
+        ++partial[2][buffer[i + 2]];
+        ++partial[3][buffer[i + 3]];
+    }
+    for (; i < buffer_len; ++i)
+        ++partial[0][buffer[i]];
+
+    int cardinal(0);
+    for (int j = 0; j < 256; ++j)
+    {
+        histogram[j] = partial[0][j] + partial[1][j] + partial[2][j] + partial[3][j];
+        cardinal += histogram[j] != 0;
     }
+    return cardinal;
+}
+
+/**
+ * @brief method for computing a pixels buffer length, checking the 64 bits overflows
+ * 
+ * @param s_width the image width
+ * @param s_height the image height
+ * @param colorChannel the number of bytes per pixel
+ * @return std::size_t the pixels buffer length
+ * 
+ * @exception std::invalid_argument if a dimension is negative
+ * @exception std::overflow_error if a line is longer than INT_MAX bytes(a scanline is filtered and unfiltered in one piece)
+ * @exception std::overflow_error if the buffer length doesn't fit in a std::size_t
+ */
+std::size_t Utilities::get_buffer_length(int s_width, int s_height, int colorChannel)
+{
+    if (s_width < 0 || s_height < 0 || colorChannel < 0)
+        throw std::invalid_argument("Utilities::get_buffer_length() - Negative image dimensions");
+
+    const uint64_t lineLength = static_cast<uint64_t>(s_width) * colorChannel;
+    if (lineLength + 1 > INT_MAX) // the filter byte included
+        throw std::overflow_error("Utilities::get_buffer_length() - Image lines are too long");
 
-    return static_cast<int>(computed.size());
-}
\ No newline at end of file
+    if (s_height > 0 && lineLength + 1 > SIZE_MAX / s_height)
+        throw std::overflow_error("Utilities::get_buffer_length() - Image too big for the address space");
+
+    return static_cast<std::size_t>(lineLength) * s_height;
+}
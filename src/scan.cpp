@@ -0,0 +1,45 @@
+// PNG CORPUS METADATAS SCANNER
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "../include/PNG/CORPUS_INDEX.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage : " << argv[0] << " <directory> <index file> [--binary] [--threads N]" << std::endl;
+        return 1;
+    }
+
+    bool binary(false);
+    int threads(0);
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string option(argv[i]);
+        if (option == "--binary")
+            binary = true;
+        else if (option == "--threads" && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+    }
+
+    try
+    {
+        // scan all the png files, then write the index
+        CORPUS_INDEX index(argv[1], threads);
+        binary ? index.save_binary(argv[2]) : index.save_csv(argv[2]);
+
+        std::size_t errors(0);
+        for (const auto &record : index.get_records())
+            errors += !record.error.empty();
+
+        std::cout << index.get_records().size() << " png files scanned, " << errors << " errors" << std::endl;
+    }
+    catch (const std::exception &exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
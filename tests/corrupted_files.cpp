@@ -0,0 +1,213 @@
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "../include/PNG/PNG.h"
+
+static int failures = 0;
+
+/**
+ * @brief reporting a check
+ *
+ */
+static void check(bool condition, const char *message)
+{
+    if (!condition)
+    {
+        std::printf("FAILED : %s\n", message);
+        ++failures;
+    }
+}
+
+/**
+ * @brief reading a whole file
+ *
+ */
+static std::vector<uint8_t> load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief writing a whole file
+ *
+ */
+static void store(const std::string &path, const std::vector<uint8_t> &content)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(content.data()), content.size());
+}
+
+/**
+ * @brief the position of the last IDAT chunk datas, and its length
+ *
+ */
+static std::size_t find_last_IDAT(const std::vector<uint8_t> &content, uint32_t &length)
+{
+    std::size_t last(0);
+    for (std::size_t pos = 8; pos + 8 <= content.size();)
+    {
+        const uint32_t chunkLength = static_cast<uint32_t>(content[pos]) << 24 | static_cast<uint32_t>(content[pos + 1]) << 16 |
+                                     static_cast<uint32_t>(content[pos + 2]) << 8  | static_cast<uint32_t>(content[pos + 3]);
+        if (memcmp(&content[pos + 4], "IDAT", 4) == 0)
+        {
+            last = pos + 8;
+            length = chunkLength;
+        }
+        pos += 12 + chunkLength;
+    }
+    return last;
+}
+
+/**
+ * @brief rewriting the length and the crc32 of a chunk, after its datas were modified
+ *
+ */
+static void set_chunk(std::vector<uint8_t> &content, std::size_t datas, uint32_t length)
+{
+    for (int i = 0; i < 4; i++)
+        content[datas - 8 + i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+
+    const uint32_t crc = static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0), &content[datas - 4], 4 + length));
+    for (int i = 0; i < 4; i++)
+        content[datas + length + i] = static_cast<uint8_t>(crc >> (24 - 8 * i));
+}
+
+/**
+ * @brief moving the adler32 checksum ending the zlib stream to a last IDAT chunk of its own,
+ * the decoders stopping at the last scanline byte don't reach it
+ *
+ */
+static void split_adler32(std::vector<uint8_t> &content)
+{
+    uint32_t length(0);
+    const std::size_t IDAT = find_last_IDAT(content, length);
+    std::vector<uint8_t> chunk = {0x0, 0x0, 0x0, 0x4, 'I', 'D', 'A', 'T'};
+    chunk.insert(chunk.end(), content.begin() + IDAT + length - 4, content.begin() + IDAT + length);
+    chunk.resize(chunk.size() + 4); // crc32
+
+    content.erase(content.begin() + IDAT + length - 4, content.begin() + IDAT + length);
+    set_chunk(content, IDAT, length - 4);
+    content.insert(content.begin() + IDAT + length, chunk.begin(), chunk.end()); // after the shortened chunk crc32
+    set_chunk(content, IDAT + length + 8, 4);
+}
+
+/**
+ * @brief the decoding of a file must succeed or be rejected, in both decode modes and all the unfiltering modes
+ *
+ */
+static void check_decoding(const std::string &path, bool valid, const char *message)
+{
+    for (int decode_mode : {PNG::DECODE::MAPPED, PNG::DECODE::BUFFERED})
+        for (int unfilter_mode : {PNG::UNFILTER::SEQUENTIAL, PNG::UNFILTER::PARALLEL, PNG::UNFILTER::PIPELINED})
+        {
+            bool rejected = false;
+            try
+            {
+                PNG png(path, decode_mode, PNG::ENDIANNESS::BIG, unfilter_mode);
+            }
+            catch (const std::runtime_error &)
+            {
+                rejected = true;
+            }
+            check(rejected != valid, message);
+        }
+}
+
+/**
+ * @brief the valid file must be decoded in all the modes, with the adler32 checksum in its own IDAT chunk too
+ *
+ */
+static void test_valid(const std::vector<uint8_t> &valid, const std::string &path)
+{
+    std::vector<uint8_t> content = valid;
+    store(path, content);
+    check_decoding(path, true, "the valid file must be decoded");
+
+    split_adler32(content);
+    store(path, content);
+    check_decoding(path, true, "the valid file with a split adler32 checksum must be decoded");
+}
+
+/**
+ * @brief a bit flipped in the IHDR height, the crc32 left as is : the header must not be trusted for the buffers sizes,
+ * a smaller height would be decoded as a valid(truncated) image
+ *
+ */
+static void test_ihdr_crc(const std::vector<uint8_t> &valid, const std::string &path)
+{
+    std::vector<uint8_t> content = valid;
+    content[23] ^= 0x04; // height low byte, after the signature(8 bytes), IHDR length and type(8 bytes) and width(4 bytes)
+    store(path, content);
+    check_decoding(path, false, "a corrupted IHDR chunk must be rejected");
+}
+
+/**
+ * @brief a byte flipped in the adler32 checksum ending the zlib stream, the IDAT crc32 updated.
+ * the checksum is in its own IDAT chunk, zlib doesn't check it while inflating the last scanline
+ *
+ */
+static void test_adler32(const std::vector<uint8_t> &valid, const std::string &path)
+{
+    std::vector<uint8_t> content = valid;
+    split_adler32(content);
+
+    uint32_t length(0);
+    const std::size_t IDAT = find_last_IDAT(content, length);
+    content[IDAT + length - 1] ^= 0xFF;
+    set_chunk(content, IDAT, length);
+    store(path, content);
+    check_decoding(path, false, "an invalid adler32 checksum must be rejected");
+}
+
+/**
+ * @brief the adler32 checksum removed from the zlib stream, the IDAT length and crc32 updated
+ *
+ */
+static void test_missing_adler32(const std::vector<uint8_t> &valid, const std::string &path)
+{
+    std::vector<uint8_t> content = valid;
+    uint32_t length(0);
+    const std::size_t IDAT = find_last_IDAT(content, length);
+    content.erase(content.begin() + IDAT + length - 4, content.begin() + IDAT + length);
+    set_chunk(content, IDAT, length - 4);
+    store(path, content);
+    check_decoding(path, false, "a missing adler32 checksum must be rejected");
+}
+
+/**
+ * @brief corrupted files decoding : the corruptions must be reported, not decoded as valid images.
+ * @return 0 if all the checks pass, 1 otherwise
+ */
+int main()
+{
+    const int width = 61, height = 37, colorChannel = 3;
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * colorChannel);
+    for (std::size_t i = 0; i < pixels.size(); i++)
+        pixels[i] = static_cast<uint8_t>(i * 7 + i / 13);
+
+    const std::string valid = "corrupted_valid.png", corrupted = "corrupted_file.png";
+    PNG png(pixels.data(), width, height, 8, 2);
+    png.save(valid);
+    const std::vector<uint8_t> content = load(valid);
+
+    test_valid(content, corrupted);
+    test_ihdr_crc(content, corrupted);
+    test_adler32(content, corrupted);
+    test_missing_adler32(content, corrupted);
+
+    std::remove(valid.c_str());
+    std::remove(corrupted.c_str());
+
+    if (failures > 0)
+    {
+        std::printf("corrupted_files : %d FAILED\n", failures);
+        return 1;
+    }
+    std::printf("corrupted_files : OK\n");
+    return 0;
+}
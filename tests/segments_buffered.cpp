@@ -0,0 +1,126 @@
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "../include/PNG/PNG.h"
+#include "../include/PNG/INPUT_FILE.h"
+
+static int failures = 0;
+
+/**
+ * @brief reporting a check
+ *
+ */
+static void check(bool condition, const char *message)
+{
+    if (!condition)
+    {
+        std::printf("FAILED : %s\n", message);
+        ++failures;
+    }
+}
+
+/**
+ * @brief a pixels buffer with noise and flat areas, so the lines don't all use the same filter
+ *
+ */
+static std::vector<uint8_t> make_pixels(int width, int height, int colorChannel)
+{
+    std::mt19937 random(42);
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * colorChannel);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width * colorChannel; x++)
+            pixels[static_cast<std::size_t>(y) * width * colorChannel + x] = ((y / 16) % 2) ? static_cast<uint8_t>(random()) : static_cast<uint8_t>(x + y);
+
+    return pixels;
+}
+
+/**
+ * @brief several threads reading ranges of the same buffered INPUT_FILE, without memory mapping
+ *
+ */
+static void test_concurrent_reads(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    INPUT_FILE input(path, false);
+    check(!input.is_mapped(), "the input file must not be mapped");
+
+    const unsigned threads_count = 8;
+    std::vector<int> errors(threads_count, 0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threads_count; t++)
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 random(t);
+            std::vector<uint8_t> buffer;
+            for (int i = 0; i < 20000; i++)
+            {
+                const uint32_t length = 1 + random() % 4096;
+                const uint64_t offset = random() % (content.size() - length);
+                if (memcmp(input.read(offset, length, buffer), content.data() + offset, length) != 0)
+                    ++errors[t];
+            }
+        });
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int error : errors)
+        check(error == 0, "concurrent buffered reads returned wrong bytes");
+}
+
+/**
+ * @brief a segmented file decoded in BUFFERED mode, compared with the serial decoding of the same image
+ *
+ */
+static void test_segments(const std::string &segmented, const std::string &serial, const std::vector<uint8_t> &pixels, std::size_t length)
+{
+    PNG reference(serial, PNG::DECODE::BUFFERED);
+    PNG decoded(segmented, PNG::DECODE::BUFFERED);
+
+    check(decoded.get_decode_mode() == PNG::DECODE::BUFFERED, "the segmented file must be decoded through the buffered stream");
+
+    uint8_t *expected = reference.get_raw_pixels();
+    uint8_t *result = decoded.get_raw_pixels();
+    check(memcmp(expected, pixels.data(), length) == 0, "the serial decoding differs from the original pixels");
+    check(memcmp(result, expected, length) == 0, "the segmented decoding differs from the serial decoding");
+    delete[] expected;
+    delete[] result;
+}
+
+/**
+ * @brief segmented(sgIX) files decoded through the buffered stream : the segments are read by several threads from a single
+ * INPUT_FILE, the result must be the same as the serial decoding.
+ * @return 0 if all the checks pass, 1 otherwise
+ */
+int main()
+{
+    const int width = 257, height = 1000, colorChannel = 4;
+    const std::vector<uint8_t> pixels = make_pixels(width, height, colorChannel);
+    const std::string segmented = "segments_buffered.png", serial = "segments_serial.png";
+
+    PNG png(pixels.data(), width, height, 8, 6);
+    png.save(segmented, PNG::COMPRESS::DEFAULT, 16);
+    png.save(serial);
+
+    test_concurrent_reads(segmented);
+    for (int i = 0; i < 20; i++) // the segments are read in a different order at each run
+        test_segments(segmented, serial, pixels, pixels.size());
+
+    std::remove(segmented.c_str());
+    std::remove(serial.c_str());
+
+    if (failures > 0)
+    {
+        std::printf("segments_buffered : %d FAILED\n", failures);
+        return 1;
+    }
+    std::printf("segments_buffered : OK\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <vector>
+#include <cstdio>
+#include <string>
+#include <fstream>
+
+#include "../include/PNG/PNG.h"
+
+static int failures = 0;
+
+/**
+ * @brief reporting a check
+ *
+ */
+static void check(bool condition, const char *message)
+{
+    if (!condition)
+    {
+        std::printf("FAILED : %s\n", message);
+        ++failures;
+    }
+}
+
+/**
+ * @brief appending a chunk(length, type, datas and crc32) to a png file content
+ *
+ */
+static void add_chunk(std::vector<uint8_t> &content, const char *type, const std::vector<uint8_t> &datas)
+{
+    const uint32_t length = static_cast<uint32_t>(datas.size());
+    for (int i = 0; i < 4; i++)
+        content.push_back(static_cast<uint8_t>(length >> (24 - 8 * i)));
+
+    const std::size_t start = content.size();
+    content.insert(content.end(), type, type + 4);
+    content.insert(content.end(), datas.begin(), datas.end());
+
+    const uint32_t crc = static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0), &content[start], 4 + length));
+    for (int i = 0; i < 4; i++)
+        content.push_back(static_cast<uint8_t>(crc >> (24 - 8 * i)));
+}
+
+/**
+ * @brief writing a png file with a tRNS chunk, the lines filtered with None
+ *
+ */
+static void write_png(const std::string &path, int width, int height, uint8_t bitDepth, uint8_t colorMode,
+                      const std::vector<uint8_t> &pixels, const std::vector<uint8_t> &transparency)
+{
+    std::vector<uint8_t> content = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+    std::vector<uint8_t> header(13, 0x0);
+    for (int i = 0; i < 4; i++)
+    {
+        header[i] = static_cast<uint8_t>(width >> (24 - 8 * i));
+        header[4 + i] = static_cast<uint8_t>(height >> (24 - 8 * i));
+    }
+    header[8] = bitDepth;
+    header[9] = colorMode;
+    add_chunk(content, "IHDR", header);
+    add_chunk(content, "tRNS", transparency);
+
+    const std::size_t rowLength = pixels.size() / height;
+    std::vector<uint8_t> scanlines;
+    for (int y = 0; y < height; y++)
+    {
+        scanlines.push_back(0x0);
+        scanlines.insert(scanlines.end(), pixels.begin() + y * rowLength, pixels.begin() + (y + 1) * rowLength);
+    }
+
+    uLongf compressedLength = compressBound(static_cast<uLong>(scanlines.size()));
+    std::vector<uint8_t> compressed(compressedLength);
+    compress(compressed.data(), &compressedLength, scanlines.data(), static_cast<uLong>(scanlines.size()));
+    compressed.resize(compressedLength);
+    add_chunk(content, "IDAT", compressed);
+    add_chunk(content, "IEND", {});
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(content.data()), content.size());
+}
+
+/**
+ * @brief the alpha channel of the RGBA pixels of a decoded file
+ *
+ */
+static std::vector<uint8_t> get_alphas(const std::string &path, int endianness)
+{
+    PNG png(path, PNG::DECODE::MAPPED, endianness);
+    uint8_t *rgba = png.get_rgba_pixels();
+
+    std::vector<uint8_t> alphas(static_cast<std::size_t>(png.get_width()) * png.get_height());
+    for (std::size_t i = 0; i < alphas.size(); i++)
+        alphas[i] = rgba[i * 4 + 3];
+    delete[] rgba;
+
+    return alphas;
+}
+
+/**
+ * @brief an 8 bits RGB image with a transparent color : only the pixel matching the three samples is transparent
+ *
+ */
+static void test_rgb8(const std::string &path)
+{
+    const std::vector<uint8_t> pixels = {10, 20, 30, 10, 20, 31, 10, 20, 30};
+    write_png(path, 3, 1, 8, 2, pixels, {0, 10, 0, 20, 0, 30});
+
+    const std::vector<uint8_t> alphas = get_alphas(path, PNG::ENDIANNESS::BIG);
+    check(alphas == std::vector<uint8_t>({0x0, 0xFF, 0x0}), "the RGB8 pixels matching the tRNS color must be transparent");
+}
+
+/**
+ * @brief a 16 bits gray image with a transparent level : compared before the rounding to 8 bits, 1235 stays opaque
+ *
+ */
+static void test_gray16(const std::string &path)
+{
+    const std::vector<uint8_t> pixels = {0x04, 0xD2, 0x04, 0xD3, 0x00, 0x00, 0x04, 0xD2}; // 1234, 1235, 0, 1234
+    write_png(path, 2, 2, 16, 0, pixels, {0x04, 0xD2});
+
+    for (int endianness : {PNG::ENDIANNESS::BIG, PNG::ENDIANNESS::NATIVE})
+    {
+        const std::vector<uint8_t> alphas = get_alphas(path, endianness);
+        check(alphas == std::vector<uint8_t>({0x0, 0xFF, 0xFF, 0x0}), "the 16 bits gray pixels matching the tRNS level must be transparent");
+    }
+}
+
+/**
+ * @brief transparency(tRNS chunk) of the gray and RGB images, in the RGBA pixels of the decoded images.
+ * @return 0 if all the checks pass, 1 otherwise
+ */
+int main()
+{
+    const std::string path = "transparency.png";
+
+    test_rgb8(path);
+    test_gray16(path);
+
+    std::remove(path.c_str());
+
+    if (failures > 0)
+    {
+        std::printf("transparency : %d FAILED\n", failures);
+        return 1;
+    }
+    std::printf("transparency : OK\n");
+    return 0;
+}